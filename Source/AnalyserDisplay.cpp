@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    AnalyserDisplay.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "AnalyserDisplay.h"
+
+AnalyserDisplay::AnalyserDisplay(AudioAnalyser& a, const TruePeakLimiter& l) : analyser(a), limiter(l)
+{
+    spectrum.fill(AudioAnalyser::minimumDecibels);
+    setOpaque(true);
+
+    analyser.setEnabled(true);
+    startTimerHz(30);
+}
+
+AnalyserDisplay::~AnalyserDisplay()
+{
+    stopTimer();
+    analyser.setEnabled(false);//back to zero cost on the audio thread
+}
+
+void AnalyserDisplay::timerCallback()
+{
+    levels = analyser.getLevels();
+    analyser.getSpectrum(spectrum);
+    gainReduction = juce::jmax(limiter.getGainReductionDecibels(), gainReduction - 0.5f);
+    repaint();
+}
+
+float AnalyserDisplay::decibelsToProportion(float decibels)
+{
+    return juce::jlimit(0.0f, 1.0f, 1.0f - decibels / AudioAnalyser::minimumDecibels);
+}
+
+void AnalyserDisplay::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black);
+
+    auto area = getLocalBounds().toFloat();
+    auto meterArea = area.removeFromRight(22.0f);
+    area.removeFromRight(4.0f);
+    auto reductionArea = area.removeFromRight(6.0f);
+    area.removeFromRight(6.0f);
+
+    paintSpectrum(g, area);
+    paintGainReduction(g, reductionArea);
+
+    auto left = meterArea.removeFromLeft(10.0f);
+    meterArea.removeFromLeft(2.0f);
+
+    paintMeter(g, left, levels.peak[0], levels.rms[0]);
+    paintMeter(g, meterArea, levels.peak[1], levels.rms[1]);
+}
+
+void AnalyserDisplay::paintSpectrum(juce::Graphics& g, juce::Rectangle<float> area)
+{
+    g.setColour(juce::Colours::darkgrey);
+    g.drawRect(area, 1.0f);
+
+    juce::Path path;
+    const float bandWidth = area.getWidth() / (float) AudioAnalyser::numSpectrumBands;
+
+    path.startNewSubPath(area.getX(), area.getBottom());
+
+    for(int band = 0; band < AudioAnalyser::numSpectrumBands; ++band){
+        auto y = area.getBottom() - decibelsToProportion(spectrum[(size_t) band]) * area.getHeight();
+        path.lineTo(area.getX() + ((float) band + 0.5f) * bandWidth, y);
+    }
+
+    path.lineTo(area.getRight(), area.getBottom());
+    path.closeSubPath();
+
+    g.setColour(juce::Colours::purple.withAlpha(0.6f));
+    g.fillPath(path);
+    g.setColour(juce::Colours::goldenrod);
+    g.strokePath(path, juce::PathStrokeType(1.0f));
+}
+
+void AnalyserDisplay::paintMeter(juce::Graphics& g, juce::Rectangle<float> area, float peak, float rms)
+{
+    g.setColour(juce::Colours::darkgrey);
+    g.fillRect(area);
+
+    auto rmsHeight = decibelsToProportion(juce::Decibels::gainToDecibels(rms, AudioAnalyser::minimumDecibels)) * area.getHeight();
+    auto peakHeight = decibelsToProportion(juce::Decibels::gainToDecibels(peak, AudioAnalyser::minimumDecibels)) * area.getHeight();
+
+    g.setColour(juce::Colours::seagreen);
+    g.fillRect(area.withTop(area.getBottom() - rmsHeight));
+
+    g.setColour(peak >= 1.0f ? juce::Colours::indianred : juce::Colours::palegoldenrod);
+    g.fillRect(area.withTop(area.getBottom() - peakHeight).withHeight(2.0f));
+}
+
+void AnalyserDisplay::paintGainReduction(juce::Graphics& g, juce::Rectangle<float> area)
+{
+    g.setColour(juce::Colours::darkgrey);
+    g.fillRect(area);
+
+    //hangs down from the top, full height is 12 dB of reduction
+    auto height = juce::jlimit(0.0f, 1.0f, gainReduction / 12.0f) * area.getHeight();
+
+    g.setColour(juce::Colours::orangered);
+    g.fillRect(area.withHeight(height));
+}
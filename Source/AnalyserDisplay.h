@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    AnalyserDisplay.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include "AudioAnalyser.h"
+#include "TruePeakLimiter.h"
+
+//==============================================================================
+/**
+    Spectrum plus a pair of peak/RMS meters and the limiter's gain reduction,
+    redrawn at display rate from whatever the analyser last published. Turns
+    the analyser on for as long as it is showing.
+*/
+class AnalyserDisplay  : public juce::Component,
+                         private juce::Timer
+{
+public:
+    AnalyserDisplay (AudioAnalyser&, const TruePeakLimiter&);
+    ~AnalyserDisplay() override;
+
+    void paint (juce::Graphics&) override;
+
+private:
+    void timerCallback() override;
+
+    void paintSpectrum (juce::Graphics&, juce::Rectangle<float> area);
+    void paintMeter (juce::Graphics&, juce::Rectangle<float> area, float peak, float rms);
+    void paintGainReduction (juce::Graphics&, juce::Rectangle<float> area);
+
+    static float decibelsToProportion (float decibels);
+
+    AudioAnalyser& analyser;
+    const TruePeakLimiter& limiter;
+    float gainReduction = 0.0f;//dB, with a slow fall so single blocks stay visible
+    AudioAnalyser::Levels levels;
+    std::array<float, AudioAnalyser::numSpectrumBands> spectrum;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalyserDisplay)
+};
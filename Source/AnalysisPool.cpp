@@ -0,0 +1,35 @@
+/*
+  ==============================================================================
+
+    AnalysisPool.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "AnalysisPool.h"
+
+AnalysisPool::AnalysisPool()
+    : juce::ThreadPool(juce::jmax(1, juce::SystemStats::getNumCpus() - 1))
+{
+    setThreadPriorities(0);
+}
+
+void AnalysisPool::removeJobsFor(const void* owner, int timeOutMs)
+{
+    struct OwnedBy  : public juce::ThreadPool::JobSelector
+    {
+        explicit OwnedBy(const void* o) : owner(o) {}
+
+        bool isJobSuitable(juce::ThreadPoolJob* job) override
+        {
+            auto* analysisJob = dynamic_cast<Job*>(job);
+            return analysisJob != nullptr && analysisJob->owner == owner;
+        }
+
+        const void* owner;
+    };
+
+    OwnedBy selector(owner);
+    removeAllJobs(true, timeOutMs, &selector);
+}
@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    AnalysisPool.h
+    Created: 19 Oct 2026
+
+    The one pool for background analysis (beat grids, fingerprints) in the
+    process, shared through a SharedResourcePointer like StreamScheduler.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    One thread short of the cores, at the lowest priority, however many
+    BeatAnalysers and FingerprintIndexes there are: each made a pool of its own,
+    so two processors and an index had three times the cores in threads, all
+    contending for the same disk and caches.
+
+    Jobs are tagged with whoever queued them, so an owner going away takes its
+    own jobs out and leaves everybody else's queued.
+*/
+class AnalysisPool  : public juce::ThreadPool
+{
+public:
+    class Job  : public juce::ThreadPoolJob
+    {
+    public:
+        Job (const juce::String& name, const void* jobOwner) : juce::ThreadPoolJob (name), owner (jobOwner) {}
+
+        const void* const owner;
+    };
+
+    AnalysisPool();
+
+    /** The pool deletes the job when it's done. */
+    void addJob (Job* job)                      { juce::ThreadPool::addJob (job, true); }
+
+    /** Removes jobs owner queued, interrupting and waiting for running ones. */
+    void removeJobsFor (const void* owner, int timeOutMs);
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalysisPool)
+};
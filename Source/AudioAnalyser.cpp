@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+    AudioAnalyser.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "AudioAnalyser.h"
+#include <algorithm>
+#include <cmath>
+
+AudioAnalyser::AudioAnalyser() : juce::Thread("MusicPlayer analyser")
+{
+    sampleBuffer.resize((size_t) sampleFifo.getTotalSize(), 0.0f);
+    analysisFrame.resize((size_t) fftSize, 0.0f);
+    fftData.resize((size_t) fftSize * 2, 0.0f);
+
+    heldSpectrum.fill(minimumDecibels);
+    publishedSpectrum.fill(minimumDecibels);
+}
+
+AudioAnalyser::~AudioAnalyser()
+{
+    stopThread(500);
+}
+
+void AudioAnalyser::prepare(double newSampleRate)
+{
+    sampleRate.store(newSampleRate);
+}
+
+void AudioAnalyser::setEnabled(bool shouldBeEnabled)
+{
+    if(shouldBeEnabled == isEnabled())
+        return;
+
+    if(shouldBeEnabled){
+        startThread(3);//well below the audio and read-ahead threads
+        enabled.store(true);
+    }
+    else{
+        enabled.store(false);
+        stopThread(500);
+    }
+}
+
+AudioAnalyser::Levels AudioAnalyser::getLevels() const
+{
+    const juce::SpinLock::ScopedLockType lock(resultLock);
+    return publishedLevels;
+}
+
+void AudioAnalyser::getSpectrum(std::array<float, numSpectrumBands>& bandsInDecibels) const
+{
+    const juce::SpinLock::ScopedLockType lock(resultLock);
+    bandsInDecibels = publishedSpectrum;
+}
+
+//==============================================================================
+void AudioAnalyser::run()
+{
+    while(! threadShouldExit()){
+
+        drainLevels();
+
+        while(sampleFifo.getNumReady() >= hopSize){
+            readHop();
+            analyseFrame();
+        }
+
+        {
+            const juce::SpinLock::ScopedLockType lock(resultLock);
+            publishedLevels = heldLevels;
+            publishedSpectrum = heldSpectrum;
+        }
+
+        wait(10);
+    }
+}
+
+void AudioAnalyser::drainLevels()
+{
+    //meters fall back by roughly 20dB a second, a loop of this thread being about 10ms
+    const float release = 0.977f;
+
+    for(int channel = 0; channel < maxChannels; ++channel){
+        heldLevels.peak[channel] *= release;
+        heldLevels.rms[channel] *= release;
+    }
+
+    int start1, size1, start2, size2;
+    const int numReady = levelFifo.getNumReady();
+    levelFifo.prepareToRead(numReady, start1, size1, start2, size2);
+
+    auto take = [this](int start, int size){
+        for(int i = start; i < start + size; ++i){
+            const auto& frame = levelFrames[(size_t) i];
+
+            for(int channel = 0; channel < maxChannels; ++channel){
+                heldLevels.peak[channel] = juce::jmax(heldLevels.peak[channel], frame.peak[channel]);
+                heldLevels.rms[channel] = juce::jmax(heldLevels.rms[channel], frame.rms[channel]);
+            }
+        }
+    };
+
+    take(start1, size1);
+    take(start2, size2);
+    levelFifo.finishedRead(size1 + size2);
+}
+
+void AudioAnalyser::readHop()
+{
+    //slide the analysis frame along by half its length (50% overlap)
+    std::copy(analysisFrame.begin() + hopSize, analysisFrame.end(), analysisFrame.begin());
+
+    int start1, size1, start2, size2;
+    sampleFifo.prepareToRead(hopSize, start1, size1, start2, size2);
+
+    auto* dest = analysisFrame.data() + (fftSize - hopSize);
+    std::copy(sampleBuffer.data() + start1, sampleBuffer.data() + start1 + size1, dest);
+    std::copy(sampleBuffer.data() + start2, sampleBuffer.data() + start2 + size2, dest + size1);
+
+    sampleFifo.finishedRead(size1 + size2);
+}
+
+void AudioAnalyser::analyseFrame()
+{
+    std::copy(analysisFrame.begin(), analysisFrame.end(), fftData.begin());
+    std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+
+    window.multiplyWithWindowingTable(fftData.data(), (size_t) fftSize);
+    fft.performFrequencyOnlyForwardTransform(fftData.data());
+
+    //a full scale sine should read 0dB: half the FFT size, times the hann window's gain of 0.5
+    const float normalise = 4.0f / (float) fftSize;
+    const float falloff = 1.5f;//dB per hop
+
+    const double nyquist = sampleRate.load() * 0.5;
+    const double lowest = 20.0;
+    const double binWidth = nyquist / (double) (fftSize / 2);
+
+    for(int band = 0; band < numSpectrumBands; ++band){
+
+        //log spaced from 20Hz up to nyquist
+        auto lowFrequency = lowest * std::pow(nyquist / lowest, (double) band / numSpectrumBands);
+        auto highFrequency = lowest * std::pow(nyquist / lowest, (double) (band + 1) / numSpectrumBands);
+
+        auto firstBin = juce::jlimit(1, fftSize / 2 - 1, (int) (lowFrequency / binWidth));
+        auto lastBin = juce::jlimit(firstBin, fftSize / 2 - 1, (int) (highFrequency / binWidth));
+
+        float magnitude = 0.0f;
+
+        for(int bin = firstBin; bin <= lastBin; ++bin)
+            magnitude = juce::jmax(magnitude, fftData[(size_t) bin]);
+
+        auto level = juce::Decibels::gainToDecibels(magnitude * normalise, minimumDecibels);
+        auto& held = heldSpectrum[(size_t) band];
+        held = juce::jmax(level, held - falloff);
+    }
+}
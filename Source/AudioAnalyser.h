@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+    AudioAnalyser.h
+    Created: 19 Oct 2026
+
+    Level meters and spectrum for the editor. The audio thread only ever pushes
+    into lock-free FIFOs, everything else happens on a background thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+/**
+    processBlock pushes one peak/RMS frame per block plus a mono copy of the
+    samples. A background thread drains them, applies meter ballistics and runs
+    a windowed FFT which it folds down into log spaced bands for display.
+
+    Nothing runs (and processBlock doesn't even call pushBlock) until an editor
+    turns the analyser on, so with no editor open metering costs one atomic load.
+*/
+class AudioAnalyser : private juce::Thread
+{
+public:
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int hopSize = fftSize / 2;
+    static constexpr int numSpectrumBands = 64;
+    static constexpr int maxChannels = 2;
+
+    struct Levels
+    {
+        float peak[maxChannels] = {};
+        float rms[maxChannels] = {};
+    };
+
+    AudioAnalyser();
+    ~AudioAnalyser() override;
+
+    void prepare (double newSampleRate);
+
+    /** Called by the editor when it opens and closes. */
+    void setEnabled (bool shouldBeEnabled);
+    bool isEnabled() const noexcept             { return enabled.load (std::memory_order_relaxed); }
+
+    /** Audio thread. Never blocks, drops data if the analysis thread falls behind. */
+    template <typename FloatType>
+    void pushBlock (const juce::AudioBuffer<FloatType>& buffer);
+
+    /** Message thread: the latest smoothed values. */
+    Levels getLevels() const;
+    void getSpectrum (std::array<float, numSpectrumBands>& bandsInDecibels) const;
+
+    static constexpr float minimumDecibels = -90.0f;
+
+private:
+    void run() override;
+    void drainLevels();
+    void readHop();
+    void analyseFrame();
+
+    template <typename FloatType>
+    void writeMono (const juce::AudioBuffer<FloatType>& buffer, int numChannels,
+                    int sourceStart, int destStart, int numSamples);
+
+    std::atomic<bool> enabled{false};
+    std::atomic<double> sampleRate{44100.0};
+
+    //audio thread -> analysis thread
+    static constexpr int levelFifoSize = 128;
+    juce::AbstractFifo levelFifo{levelFifoSize};
+    std::array<Levels, levelFifoSize> levelFrames;
+
+    juce::AbstractFifo sampleFifo{fftSize * 4};
+    std::vector<float> sampleBuffer;
+
+    //analysis thread only
+    juce::dsp::FFT fft{fftOrder};
+    juce::dsp::WindowingFunction<float> window{(size_t) fftSize, juce::dsp::WindowingFunction<float>::hann, false};
+    std::vector<float> analysisFrame;//the last fftSize samples
+    std::vector<float> fftData;//2 * fftSize, as the FFT wants
+    Levels heldLevels;
+    std::array<float, numSpectrumBands> heldSpectrum;
+
+    //analysis thread -> message thread. neither of these is the audio thread so a lock is fine
+    juce::SpinLock resultLock;
+    Levels publishedLevels;
+    std::array<float, numSpectrumBands> publishedSpectrum;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioAnalyser)
+};
+
+//==============================================================================
+template <typename FloatType>
+void AudioAnalyser::pushBlock(const juce::AudioBuffer<FloatType>& buffer)
+{
+    const int numChannels = juce::jmin(buffer.getNumChannels(), (int) maxChannels);
+    const int numSamples = buffer.getNumSamples();
+
+    if(numChannels == 0 || numSamples == 0)
+        return;
+
+    Levels frame;
+
+    for(int channel = 0; channel < numChannels; ++channel){
+        frame.peak[channel] = (float) buffer.getMagnitude(channel, 0, numSamples);
+        frame.rms[channel] = (float) buffer.getRMSLevel(channel, 0, numSamples);
+    }
+
+    if(numChannels == 1){
+        frame.peak[1] = frame.peak[0];
+        frame.rms[1] = frame.rms[0];
+    }
+
+    int start1, size1, start2, size2;
+    levelFifo.prepareToWrite(1, start1, size1, start2, size2);
+
+    if(size1 > 0){
+        levelFrames[(size_t) start1] = frame;
+        levelFifo.finishedWrite(1);
+    }
+
+    //mono sum for the spectrum. the window is applied on the analysis thread
+    sampleFifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+    writeMono(buffer, numChannels, 0, start1, size1);
+    writeMono(buffer, numChannels, size1, start2, size2);
+    sampleFifo.finishedWrite(size1 + size2);
+}
+
+template <typename FloatType>
+void AudioAnalyser::writeMono(const juce::AudioBuffer<FloatType>& buffer, int numChannels,
+                              int sourceStart, int destStart, int numSamples)
+{
+    if(numSamples <= 0)
+        return;
+
+    auto* dest = sampleBuffer.data() + destStart;
+    const auto scale = (FloatType) 1 / (FloatType) numChannels;
+
+    auto* first = buffer.getReadPointer(0, sourceStart);
+
+    for(int i = 0; i < numSamples; ++i)
+        dest[i] = (float) (first[i] * scale);
+
+    for(int channel = 1; channel < numChannels; ++channel){
+
+        auto* source = buffer.getReadPointer(channel, sourceStart);
+
+        for(int i = 0; i < numSamples; ++i)
+            dest[i] += (float) (source[i] * scale);
+    }
+}
@@ -0,0 +1,360 @@
+/*
+  ==============================================================================
+
+    BeatAnalyser.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "BeatAnalyser.h"
+#include <algorithm>
+#include <vector>
+
+#if JUCE_LINUX
+ #include <sys/resource.h>
+#endif
+
+namespace
+{
+    constexpr int fftOrder = 10;
+    constexpr int fftSize = 1 << fftOrder;
+    constexpr int hopSize = fftSize / 2;
+    constexpr int readBlockSize = 65536;
+    constexpr double minBpm = 60.0;
+    constexpr double maxBpm = 200.0;
+    constexpr double lowBandHz = 150.0;//kick and bass, which mostly land on the downbeat
+
+    //takes the moving average out and keeps what's left above it, so only onsets remain
+    void keepPeaksAboveLocalMean(std::vector<float>& envelope, int halfWidth)
+    {
+        std::vector<float> result(envelope.size());
+        double sum = 0.0;
+        int count = 0;
+
+        for(int i = 0; i < (int) envelope.size() + halfWidth; ++i){
+
+            if(i < (int) envelope.size()){ sum += envelope[(size_t) i]; ++count; }
+            if(i - 2 * halfWidth - 1 >= 0){ sum -= envelope[(size_t) (i - 2 * halfWidth - 1)]; --count; }
+
+            auto centre = i - halfWidth;
+
+            if(centre >= 0)
+                result[(size_t) centre] = juce::jmax(0.0f, envelope[(size_t) centre] - (float) (sum / count));
+        }
+
+        envelope.swap(result);
+    }
+
+    float sampleAt(const std::vector<float>& envelope, double frame)
+    {
+        auto index = (size_t) std::lround(frame);
+        return index < envelope.size() ? envelope[index] : 0.0f;
+    }
+}
+
+//==============================================================================
+class BeatAnalyser::AnalysisJob  : public AnalysisPool::Job
+{
+public:
+    AnalysisJob(BeatAnalyser& o, const juce::File& f) : AnalysisPool::Job("Beat analysis", &o), owner(o), file(f) {}
+
+    JobStatus runJob() override
+    {
+       #if JUCE_LINUX
+        //on top of the lowest thread priority: the scheduler hands us whatever is left over
+        setpriority(PRIO_PROCESS, 0, 19);
+       #endif
+
+        //checked between reads, so that's where we give way to streams about to run dry
+        owner.runAnalysis(file, [this]{
+            owner.streams->waitWhileStreamsAreUrgent(500);
+            return shouldExit();
+        });
+        return jobHasFinished;
+    }
+
+private:
+    BeatAnalyser& owner;
+    juce::File file;
+};
+
+//==============================================================================
+BeatAnalyser::BeatAnalyser(juce::AudioFormatManager& fm)
+    : formatManager(fm)
+{
+}
+
+BeatAnalyser::~BeatAnalyser()
+{
+    pool->removeJobsFor(this, 5000);
+}
+
+void BeatAnalyser::analyse(const juce::File& file)
+{
+    if(! enabled.load())
+        return;
+
+    auto path = file.getFullPathName();
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        if(grids.find(path) != grids.end() || pending.contains(path))
+            return;
+
+        pending.add(path);
+    }
+
+    pool->addJob(new AnalysisJob(*this, file));
+}
+
+void BeatAnalyser::analyseFolder(const juce::File& folder)
+{
+    for(auto& file : folder.findChildFiles(juce::File::findFiles, true, formatManager.getWildcardForAllFormats()))
+        analyse(file);
+}
+
+bool BeatAnalyser::getGrid(const juce::File& file, BeatGrid& result) const
+{
+    const juce::ScopedLock sl(lock);
+
+    auto found = grids.find(file.getFullPathName());
+
+    if(found == grids.end())
+        return false;
+
+    result = found->second;
+    return true;
+}
+
+int BeatAnalyser::getNumPending() const
+{
+    const juce::ScopedLock sl(lock);
+    return pending.size();
+}
+
+void BeatAnalyser::runAnalysis(const juce::File& file, const std::function<bool()>& shouldExit)
+{
+    BeatGrid grid;
+    bool found = readCache(file, grid);
+
+    if(! found){
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+
+        if(reader != nullptr && analyseReader(*reader, grid, shouldExit)){
+            writeCache(file, grid);
+            found = true;
+        }
+    }
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        pending.removeString(file.getFullPathName());
+
+        if(found)
+            grids[file.getFullPathName()] = grid;
+    }
+
+    if(found)
+        sendChangeMessage();
+}
+
+//==============================================================================
+bool BeatAnalyser::analyseReader(juce::AudioFormatReader& reader, BeatGrid& result,
+                                 const std::function<bool()>& shouldExit)
+{
+    auto length = reader.lengthInSamples;
+
+    if(reader.sampleRate <= 0.0 || reader.numChannels == 0 || length < fftSize * 16)
+        return false;
+
+    juce::dsp::FFT fft(fftOrder);
+    juce::dsp::WindowingFunction<float> window((size_t) fftSize, juce::dsp::WindowingFunction<float>::hann, false);
+
+    std::vector<float> fftData((size_t) fftSize * 2);
+    std::vector<float> previous((size_t) fftSize / 2 + 1, 0.0f);
+    std::vector<float> flux, lowFlux;
+    flux.reserve((size_t) (length / hopSize) + 1);
+    lowFlux.reserve((size_t) (length / hopSize) + 1);
+
+    auto lowBins = juce::jmax(2, (int) (lowBandHz * fftSize / reader.sampleRate));
+
+    juce::AudioBuffer<float> block((int) reader.numChannels, readBlockSize);
+    std::vector<float> mono;
+    mono.reserve((size_t) (readBlockSize + fftSize));
+
+    //onset envelope: how much the log spectrum rises from one frame to the next
+    for(juce::int64 position = 0; position < length; position += readBlockSize){
+
+        if(shouldExit())
+            return false;
+
+        auto numSamples = (int) juce::jmin((juce::int64) readBlockSize, length - position);
+        reader.read(&block, 0, numSamples, position, true, true);
+
+        auto gain = 1.0f / (float) block.getNumChannels();
+
+        for(int i = 0; i < numSamples; ++i){
+            float sum = 0.0f;
+
+            for(int channel = 0; channel < block.getNumChannels(); ++channel)
+                sum += block.getSample(channel, i);
+
+            mono.push_back(sum * gain);
+        }
+
+        size_t offset = 0;
+
+        for(; mono.size() - offset >= (size_t) fftSize; offset += hopSize){
+
+            std::copy(mono.begin() + (std::ptrdiff_t) offset, mono.begin() + (std::ptrdiff_t) offset + fftSize, fftData.begin());
+            window.multiplyWithWindowingTable(fftData.data(), (size_t) fftSize);
+            fft.performFrequencyOnlyForwardTransform(fftData.data());
+
+            float rise = 0.0f, lowRise = 0.0f;
+
+            for(int bin = 1; bin <= fftSize / 2; ++bin){
+
+                auto magnitude = std::log1p(100.0f * fftData[(size_t) bin]);
+                auto difference = magnitude - previous[(size_t) bin];
+                previous[(size_t) bin] = magnitude;
+
+                if(difference > 0.0f){
+                    rise += difference;
+
+                    if(bin <= lowBins)
+                        lowRise += difference;
+                }
+            }
+
+            flux.push_back(rise);
+            lowFlux.push_back(lowRise);
+        }
+
+        mono.erase(mono.begin(), mono.begin() + (std::ptrdiff_t) offset);
+    }
+
+    auto frameRate = reader.sampleRate / hopSize;
+    keepPeaksAboveLocalMean(flux, (int) (frameRate * 0.25));
+    keepPeaksAboveLocalMean(lowFlux, (int) (frameRate * 0.25));
+
+    //tempo: the autocorrelation peak in range, leaning towards 120 bpm so we don't pick double or half
+    auto minLag = (int) std::floor(60.0 * frameRate / maxBpm);
+    auto maxLag = (int) std::ceil(60.0 * frameRate / minBpm);
+    auto numFrames = (int) flux.size();
+
+    if(minLag < 2 || numFrames < maxLag * 4)
+        return false;
+
+    std::vector<double> correlation((size_t) maxLag + 2, 0.0);
+
+    for(int lag = minLag - 1; lag <= maxLag + 1; ++lag){
+
+        if(shouldExit())
+            return false;
+
+        double sum = 0.0;
+
+        for(int i = 0; i + lag < numFrames; ++i)
+            sum += (double) flux[(size_t) i] * flux[(size_t) (i + lag)];
+
+        correlation[(size_t) lag] = sum / (numFrames - lag);
+    }
+
+    int bestLag = 0;
+    double bestScore = 0.0;
+
+    for(int lag = minLag; lag <= maxLag; ++lag){
+
+        auto bpm = 60.0 * frameRate / lag;
+        auto octavesFrom120 = std::log2(bpm / 120.0);
+        auto score = correlation[(size_t) lag] * std::exp(-0.5 * octavesFrom120 * octavesFrom120 / 0.8);
+
+        if(score > bestScore){
+            bestScore = score;
+            bestLag = lag;
+        }
+    }
+
+    if(bestLag == 0)
+        return false;
+
+    //between frames: fit a parabola through the peak
+    auto before = correlation[(size_t) bestLag - 1], peak = correlation[(size_t) bestLag], after = correlation[(size_t) bestLag + 1];
+    auto curvature = before - 2.0 * peak + after;
+    auto period = bestLag + (curvature < 0.0 ? 0.5 * (before - after) / curvature : 0.0);
+
+    //phase: where a comb at that period collects the most onsets across the whole file
+    int bestOffset = 0;
+    double bestPhaseScore = -1.0;
+
+    for(int offset = 0; offset < (int) std::ceil(period); ++offset){
+
+        double sum = 0.0;
+
+        for(double frame = offset; frame < numFrames; frame += period)
+            sum += sampleAt(flux, frame);
+
+        if(sum > bestPhaseScore){
+            bestPhaseScore = sum;
+            bestOffset = offset;
+        }
+    }
+
+    //downbeat: the beat of the bar with the most low end
+    double barScores[4] = {};
+    int beat = 0;
+
+    for(double frame = bestOffset; frame < numFrames; frame += period, ++beat)
+        barScores[beat % 4] += sampleAt(lowFlux, frame);
+
+    auto downbeat = (int) (std::max_element(barScores, barScores + 4) - barScores);
+
+    //each flux value belongs to the middle of its frame
+    auto frameToSeconds = [&](double frame){ return (frame * hopSize + fftSize / 2) / reader.sampleRate; };
+
+    result.bpm = 60.0 * frameRate / period;
+    result.beatsPerBar = 4;
+    result.firstBeatSeconds = frameToSeconds(bestOffset);
+    result.firstDownbeatSeconds = frameToSeconds(bestOffset + downbeat * period);
+    return true;
+}
+
+//==============================================================================
+juce::File BeatAnalyser::getCacheFile(const juce::File& file)
+{
+    return file.getSiblingFile(file.getFileName() + ".beatgrid");
+}
+
+bool BeatAnalyser::readCache(const juce::File& file, BeatGrid& result)
+{
+    auto xml = juce::parseXML(getCacheFile(file));
+
+    //only if it was made from the file as it is now
+    if(xml == nullptr || ! xml->hasTagName("BEATGRID")
+        || xml->getStringAttribute("size") != juce::String(file.getSize())
+        || xml->getStringAttribute("modified") != juce::String(file.getLastModificationTime().toMilliseconds()))
+        return false;
+
+    result.bpm = xml->getDoubleAttribute("bpm");
+    result.firstBeatSeconds = xml->getDoubleAttribute("firstBeat");
+    result.firstDownbeatSeconds = xml->getDoubleAttribute("firstDownbeat");
+    result.beatsPerBar = xml->getIntAttribute("beatsPerBar", 4);
+    return result.isValid();
+}
+
+void BeatAnalyser::writeCache(const juce::File& file, const BeatGrid& grid)
+{
+    juce::XmlElement xml("BEATGRID");
+    xml.setAttribute("bpm", grid.bpm);
+    xml.setAttribute("firstBeat", grid.firstBeatSeconds);
+    xml.setAttribute("firstDownbeat", grid.firstDownbeatSeconds);
+    xml.setAttribute("beatsPerBar", grid.beatsPerBar);
+    xml.setAttribute("size", juce::String(file.getSize()));
+    xml.setAttribute("modified", juce::String(file.getLastModificationTime().toMilliseconds()));
+
+    xml.writeTo(getCacheFile(file));//a read-only folder just means analysing again next time
+}
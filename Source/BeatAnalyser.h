@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    BeatAnalyser.h
+    Created: 19 Oct 2026
+
+    Tempo, beat grid and downbeats for whole files, worked out in the background
+    and cached next to each file.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <map>
+#include "AnalysisPool.h"
+#include "StreamScheduler.h"
+
+//==============================================================================
+/** A constant-tempo grid: every beat is firstBeatSeconds plus a whole number of beats. */
+struct BeatGrid
+{
+    double bpm = 0.0;
+    double firstBeatSeconds = 0.0;
+    double firstDownbeatSeconds = 0.0;
+    int beatsPerBar = 4;
+
+    bool isValid() const                { return bpm > 0.0; }
+    double getBeatSeconds() const       { return 60.0 / bpm; }
+    double getBarSeconds() const        { return getBeatSeconds() * beatsPerBar; }
+
+    /** The last downbeat at or before a time. */
+    double getDownbeatAtOrBefore (double seconds) const
+    {
+        auto bar = getBarSeconds();
+        return firstDownbeatSeconds + std::floor((seconds - firstDownbeatSeconds) / bar) * bar;
+    }
+};
+
+//==============================================================================
+/**
+    Runs beat analysis in the AnalysisPool, one thread fewer than there are cores
+    at the lowest priority, so a folder's worth of files spreads across the machine
+    without ever getting in the way of the audio or read-ahead threads.
+
+    The analysis is an onset envelope (spectral flux of the log magnitude), whose
+    autocorrelation gives the tempo, a comb over the whole file gives the phase,
+    and the beat of the bar with the most low end onsets gives the downbeat.
+
+    Results go into <file>.beatgrid next to the audio, so each file is only
+    analysed once. A change message goes out whenever a new grid is ready.
+*/
+class BeatAnalyser  : public juce::ChangeBroadcaster
+{
+public:
+    explicit BeatAnalyser (juce::AudioFormatManager& formatManager);
+    ~BeatAnalyser() override;
+
+    /** Queues a file, unless it's done or already waiting. */
+    void analyse (const juce::File& file);
+
+    /** Queues every file in a folder (and below it) that formatManager can read. */
+    void analyseFolder (const juce::File& folder);
+
+    /** Returns false if the file hasn't been analysed (yet). */
+    bool getGrid (const juce::File& file, BeatGrid& result) const;
+
+    int getNumPending() const;
+
+    /** While disabled, analyse() queues nothing; grids already made are still there. */
+    void setEnabled (bool shouldBeEnabled) noexcept     { enabled = shouldBeEnabled; }
+
+    /** The analysis itself. Returns false if there's too little audio, or shouldExit said so. */
+    static bool analyseReader (juce::AudioFormatReader& reader, BeatGrid& result,
+                               const std::function<bool()>& shouldExit);
+
+private:
+    class AnalysisJob;
+
+    void runAnalysis (const juce::File& file, const std::function<bool()>& shouldExit);
+    static juce::File getCacheFile (const juce::File& file);
+    static bool readCache (const juce::File& file, BeatGrid& result);
+    static void writeCache (const juce::File& file, const BeatGrid& grid);
+
+    juce::AudioFormatManager& formatManager;
+    juce::SharedResourcePointer<AnalysisPool> pool;//shared with every other analyser and index
+    juce::SharedResourcePointer<StreamScheduler> streams;//analysis steps aside while a stream is short
+
+    juce::CriticalSection lock;
+    std::map<juce::String, BeatGrid> grids;//by full path
+    juce::StringArray pending;
+    std::atomic<bool> enabled{true};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BeatAnalyser)
+};
@@ -0,0 +1,318 @@
+/*
+  ==============================================================================
+
+    EqualiserChain.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "EqualiserChain.h"
+#include <cmath>
+
+namespace
+{
+    juce::String bandId(int band, const char* suffix)
+    {
+        return "EQ" + juce::String(band + 1) + suffix;
+    }
+
+    juce::NormalisableRange<float> frequencyRange(float low, float high)
+    {
+        juce::NormalisableRange<float> range(low, high, 1.0f);
+        range.setSkewForCentre(std::sqrt(low * high));//even steps per octave
+        return range;
+    }
+
+    constexpr float highPassOff = 10.0f;//below anything audible
+    constexpr float minQ = 0.1f;
+    constexpr float maxQ = 10.0f;
+}
+
+//==============================================================================
+void EqualiserChain::addParameters(std::vector<std::unique_ptr<juce::RangedAudioParameter>>& params)
+{
+    params.push_back(std::make_unique<juce::AudioParameterBool>("HPON","High-Pass",false));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>("HPFREQ","High-Pass Frequency",frequencyRange(20.0f,2000.0f),20.0f));//Hz
+
+    for(int band = 0; band < numBands; ++band){
+
+        //the defaults spread the bands an octave apart, 31 Hz to 16 kHz
+        auto centre = 31.25f * std::pow(2.0f, (float) band);
+        auto name = "EQ " + juce::String(band + 1);
+
+        params.push_back(std::make_unique<juce::AudioParameterBool>(bandId(band,"ON"),name,false));
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(bandId(band,"FREQ"),name + " Frequency",frequencyRange(20.0f,20000.0f),centre));//Hz
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(bandId(band,"GAIN"),name + " Gain",
+                juce::NormalisableRange<float>(-24.0f,24.0f,0.1f),0.0f));//dB
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(bandId(band,"Q"),name + " Q",
+                juce::NormalisableRange<float>(minQ,maxQ,0.01f,0.3f),1.0f));
+    }
+
+    params.push_back(std::make_unique<juce::AudioParameterBool>("LPON","Low-Pass",false));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>("LPFREQ","Low-Pass Frequency",frequencyRange(1000.0f,20000.0f),20000.0f));//Hz
+}
+
+EqualiserChain::EqualiserChain(juce::AudioProcessorValueTreeState& apvts)
+{
+    auto& highPass = filters.front();
+    highPass.type = FilterType::highPass;
+    highPass.enabled = apvts.getRawParameterValue("HPON");
+    highPass.frequency = apvts.getRawParameterValue("HPFREQ");
+
+    for(int band = 0; band < numBands; ++band){
+        auto& filter = filters[(size_t) band + 1];
+        filter.type = FilterType::peak;
+        filter.enabled = apvts.getRawParameterValue(bandId(band,"ON"));
+        filter.frequency = apvts.getRawParameterValue(bandId(band,"FREQ"));
+        filter.gain = apvts.getRawParameterValue(bandId(band,"GAIN"));
+        filter.q = apvts.getRawParameterValue(bandId(band,"Q"));
+    }
+
+    auto& lowPass = filters.back();
+    lowPass.type = FilterType::lowPass;
+    lowPass.enabled = apvts.getRawParameterValue("LPON");
+    lowPass.frequency = apvts.getRawParameterValue("LPFREQ");
+}
+
+void EqualiserChain::prepare(double newSampleRate, int maximumBlockSize)
+{
+    sampleRate = newSampleRate;
+
+    //room for the registers plus whatever it takes to align the first one
+    frameCapacity = juce::jmax(maximumBlockSize, subBlockSize);
+    frameMemory.allocate((size_t) (frameCapacity + 2) * sizeof(juce::dsp::SIMDRegister<double>), true);
+
+    for(auto& filter : filters){
+        filter.smoothedFrequency.reset(sampleRate, smoothingSeconds);
+        filter.smoothedGain.reset(sampleRate, smoothingSeconds);
+        filter.smoothedQ.reset(sampleRate, smoothingSeconds);
+        filter.mix.reset(sampleRate, smoothingSeconds);
+    }
+
+    reset();
+}
+
+void EqualiserChain::reset()
+{
+    for(auto& filter : filters){
+
+        filter.active = filter.enabled->load() > 0.5f;
+
+        filter.smoothedFrequency.setCurrentAndTargetValue(filter.active ? filter.frequency->load() : getNeutralFrequency(filter));
+
+        if(filter.type == FilterType::peak){
+            filter.smoothedGain.setCurrentAndTargetValue(filter.active ? filter.gain->load() : 0.0f);
+            filter.smoothedQ.setCurrentAndTargetValue(filter.q->load());
+        }
+
+        filter.mix.setCurrentAndTargetValue(filter.active || filter.type == FilterType::peak ? 1.0f : 0.0f);
+        filter.coefficients = makeCoefficients(filter);
+        filter.state = {};
+    }
+}
+
+//==============================================================================
+float EqualiserChain::getNeutralFrequency(const Filter& filter) const
+{
+    switch(filter.type){
+        case FilterType::highPass: return highPassOff;
+        case FilterType::lowPass:  return (float) (sampleRate * 0.49);
+        case FilterType::peak:     return filter.frequency->load();//a band at 0 dB is flat wherever it is
+    }
+
+    return 1000.0f;
+}
+
+void EqualiserChain::updateTargets()
+{
+    for(auto& filter : filters){
+
+        bool enabled = filter.enabled->load() > 0.5f;
+
+        if(enabled && ! filter.active){
+
+            //comes in from neutral (and dry), with nothing left over from last time it ran
+            filter.active = true;
+            filter.state = {};
+            filter.smoothedFrequency.setCurrentAndTargetValue(getNeutralFrequency(filter));
+            filter.smoothedGain.setCurrentAndTargetValue(0.0f);
+            filter.smoothedQ.setCurrentAndTargetValue(filter.type == FilterType::peak ? filter.q->load() : 1.0f);
+            filter.mix.setCurrentAndTargetValue(filter.type == FilterType::peak ? 1.0f : 0.0f);
+        }
+
+        if(! filter.active)
+            continue;
+
+        filter.smoothedFrequency.setTargetValue(enabled ? filter.frequency->load() : getNeutralFrequency(filter));
+
+        if(filter.type == FilterType::peak){
+            filter.smoothedGain.setTargetValue(enabled ? filter.gain->load() : 0.0f);
+            filter.smoothedQ.setTargetValue(filter.q->load());
+        }
+        else{
+            //a pass filter fades out once it's at neutral, to a true bypass
+            filter.mix.setTargetValue(enabled || filter.smoothedFrequency.isSmoothing() ? 1.0f : 0.0f);
+        }
+
+        //off and all the way back to neutral (and dry): skipped from now on
+        if(! enabled && ! isSmoothing(filter))
+            filter.active = false;
+    }
+}
+
+bool EqualiserChain::isSmoothing(const Filter& filter) const
+{
+    return filter.smoothedFrequency.isSmoothing() || filter.smoothedGain.isSmoothing() || filter.smoothedQ.isSmoothing()
+        || filter.mix.isSmoothing();
+}
+
+void EqualiserChain::skipSmoothing(Filter& filter, int numSamples)
+{
+    filter.smoothedFrequency.skip(numSamples);
+    filter.smoothedGain.skip(numSamples);
+    filter.smoothedQ.skip(numSamples);
+    filter.mix.skip(numSamples);
+}
+
+EqualiserChain::Coefficients EqualiserChain::makeCoefficients(const Filter& filter) const
+{
+    auto frequency = juce::jlimit(1.0, sampleRate * 0.49, (double) filter.smoothedFrequency.getCurrentValue());
+    auto w0 = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+    auto cosW0 = std::cos(w0);
+    auto sinW0 = std::sin(w0);
+
+    double b0, b1, b2, a0, a1, a2;
+
+    if(filter.type == FilterType::peak){
+
+        auto a = std::pow(10.0, filter.smoothedGain.getCurrentValue() / 40.0);
+        auto alpha = sinW0 / (2.0 * juce::jlimit((double) minQ, (double) maxQ, (double) filter.smoothedQ.getCurrentValue()));
+
+        b0 = 1.0 + alpha * a;
+        b1 = -2.0 * cosW0;
+        b2 = 1.0 - alpha * a;
+        a0 = 1.0 + alpha / a;
+        a1 = -2.0 * cosW0;
+        a2 = 1.0 - alpha / a;
+    }
+    else{
+
+        auto alpha = sinW0 / juce::MathConstants<double>::sqrt2;//Q = 1/sqrt(2), Butterworth
+        auto sign = filter.type == FilterType::highPass ? -1.0 : 1.0;
+
+        b0 = (1.0 - sign * cosW0) * 0.5;
+        b1 = sign * (1.0 - sign * cosW0);
+        b2 = b0;
+        a0 = 1.0 + alpha;
+        a1 = -2.0 * cosW0;
+        a2 = 1.0 - alpha;
+    }
+
+    return { b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0 };
+}
+
+//==============================================================================
+void EqualiserChain::processFilter(Filter& filter, Register* frames, int numFrames, float mixStart, float mixEnd)
+{
+    auto& c = filter.coefficients;
+    auto b0 = Register::expand(c.b0), b1 = Register::expand(c.b1), b2 = Register::expand(c.b2);
+    auto a1 = Register::expand(c.a1), a2 = Register::expand(c.a2);
+
+    auto s1 = filter.state.s1, s2 = filter.state.s2;
+
+    if(mixStart >= 1.0f && mixEnd >= 1.0f){
+
+        for(int i = 0; i < numFrames; ++i){
+            auto x = frames[i];
+            auto y = b0 * x + s1;
+            s1 = b1 * x - a1 * y + s2;
+            s2 = b2 * x - a2 * y;
+            frames[i] = y;
+        }
+    }
+    else{
+
+        //fading in or out against the input, a step a sample
+        auto mix = (double) mixStart;
+        auto step = ((double) mixEnd - mix) / numFrames;
+
+        for(int i = 0; i < numFrames; ++i){
+            auto x = frames[i];
+            auto y = b0 * x + s1;
+            s1 = b1 * x - a1 * y + s2;
+            s2 = b2 * x - a2 * y;
+            mix += step;
+            frames[i] = x + (y - x) * Register::expand(mix);
+        }
+    }
+
+    filter.state.s1 = s1;
+    filter.state.s2 = s2;
+}
+
+template <typename FloatType>
+void EqualiserChain::process(juce::AudioBuffer<FloatType>& buffer)
+{
+    updateTargets();
+
+    bool anyActive = false;
+
+    for(auto& filter : filters)
+        anyActive = anyActive || filter.active;
+
+    if(! anyActive || frameCapacity == 0)
+        return;
+
+    juce::ScopedNoDenormals noDenormals;
+
+    constexpr int numLanes = (int) Register::SIMDNumElements;
+    auto numChannels = juce::jmin(buffer.getNumChannels(), numLanes, 2);
+    auto* frames = reinterpret_cast<Register*>(Register::getNextSIMDAlignedPtr(reinterpret_cast<double*>(frameMemory.getData())));
+    auto* lanes = reinterpret_cast<double*>(frames);//the same memory as plain doubles, numLanes to a frame
+
+    for(int chunkStart = 0; chunkStart < buffer.getNumSamples(); chunkStart += frameCapacity){
+
+        auto numFrames = juce::jmin(frameCapacity, buffer.getNumSamples() - chunkStart);
+
+        //interleave: lane n of each register is channel n. strided stores through plain pointers,
+        //which compile to unpacks (and float to double conversions), not SIMDRegister::set lane by lane.
+        //lanes past the channels were zeroed by prepare and stay zero: silence through a filter at rest
+        for(int channel = 0; channel < numChannels; ++channel){
+            auto* source = buffer.getReadPointer(channel, chunkStart);
+
+            for(int i = 0; i < numFrames; ++i)
+                lanes[i * numLanes + channel] = (double) source[i];
+        }
+
+        for(int start = 0; start < numFrames; start += subBlockSize){
+
+            auto num = juce::jmin(subBlockSize, numFrames - start);
+
+            for(auto& filter : filters){
+
+                if(! filter.active)
+                    continue;
+
+                auto mixStart = filter.mix.getCurrentValue();
+
+                if(isSmoothing(filter)){
+                    skipSmoothing(filter, num);
+                    filter.coefficients = makeCoefficients(filter);
+                }
+
+                processFilter(filter, frames + start, num, mixStart, filter.mix.getCurrentValue());
+            }
+        }
+
+        for(int channel = 0; channel < numChannels; ++channel){
+            auto* dest = buffer.getWritePointer(channel, chunkStart);
+
+            for(int i = 0; i < numFrames; ++i)
+                dest[i] = (FloatType) lanes[i * numLanes + channel];
+        }
+    }
+}
+
+template void EqualiserChain::process(juce::AudioBuffer<float>&);
+template void EqualiserChain::process(juce::AudioBuffer<double>&);
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    EqualiserChain.h
+    Created: 19 Oct 2026
+
+    The insert chain after the transport: a high-pass, up to ten parametric
+    bands and a low-pass, all from apvts parameters.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+    Biquads (RBJ cookbook, transposed direct form II) run on SIMDRegister<double>
+    with one channel per lane, so left and right go through each filter together.
+    That's two lanes on SSE2 and NEON, which stereo fills, where float's four
+    would leave half of each register idle. Float hosts are filtered in double
+    too; the conversion is folded into interleaving.
+
+    Frequency, gain and Q are smoothed and the coefficients worked out again
+    every subBlockSize samples while they move, so sweeping a band doesn't
+    zipper. A band that is switched off first glides to where it does nothing
+    and is then skipped altogether. A peak band at 0 dB is exactly flat, but
+    the pass filters at the edge of the range aren't (a low-pass at 0.49 fs
+    still takes a few dB off the top octave), so they are also faded against
+    the dry signal on their way out, and in. With every band off the chain
+    costs a few atomic loads a block.
+*/
+class EqualiserChain
+{
+public:
+    static constexpr int numBands = 10;
+    static constexpr int subBlockSize = 32;
+    static constexpr double smoothingSeconds = 0.05;
+
+    /** Adds EQ1ON..EQ10Q, HPON, HPFREQ, LPON and LPFREQ. */
+    static void addParameters (std::vector<std::unique_ptr<juce::RangedAudioParameter>>& params);
+
+    explicit EqualiserChain (juce::AudioProcessorValueTreeState& apvts);
+
+    void prepare (double sampleRate, int maximumBlockSize);
+    void reset();
+
+    /** Audio thread. Filters the first two channels in place. */
+    template <typename FloatType>
+    void process (juce::AudioBuffer<FloatType>& buffer);
+
+private:
+    enum class FilterType { peak, highPass, lowPass };
+
+    struct Coefficients
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+    };
+
+    using Register = juce::dsp::SIMDRegister<double>;
+
+    struct State
+    {
+        Register s1, s2;
+    };
+
+    struct Filter
+    {
+        FilterType type = FilterType::peak;
+        std::atomic<float>* enabled = nullptr;
+        std::atomic<float>* frequency = nullptr;
+        std::atomic<float>* gain = nullptr;//peak bands only
+        std::atomic<float>* q = nullptr;//peak bands only
+
+        juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> smoothedFrequency;
+        juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> smoothedGain;
+        juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> smoothedQ;
+        juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> mix;//0 is dry, peak bands stay at 1
+
+        bool active = false;//false once it's off, at neutral and faded out: skipped
+        Coefficients coefficients;
+        State state;
+    };
+
+    void updateTargets();
+    bool isSmoothing (const Filter& filter) const;
+    void skipSmoothing (Filter& filter, int numSamples);
+    float getNeutralFrequency (const Filter& filter) const;
+    Coefficients makeCoefficients (const Filter& filter) const;
+
+    static void processFilter (Filter& filter, Register* frames, int numFrames, float mixStart, float mixEnd);
+
+    std::array<Filter, numBands + 2> filters;//high-pass, the bands, low-pass
+    double sampleRate = 44100.0;
+
+    //interleaved: one register per sample, one lane per channel
+    juce::HeapBlock<char> frameMemory;
+    int frameCapacity = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EqualiserChain)
+};
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    FileGrowthWatcher.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "FileGrowthWatcher.h"
+
+#if JUCE_LINUX
+ #include <poll.h>
+ #include <sys/inotify.h>
+ #include <unistd.h>
+#endif
+
+FileGrowthWatcher::FileGrowthWatcher(const juce::File& f, std::function<void()> callback)
+    : juce::Thread("MusicPlayer file watcher"), file(f), onChange(std::move(callback))
+{
+    startThread(2);
+}
+
+FileGrowthWatcher::~FileGrowthWatcher()
+{
+    stopThread(1000);
+}
+
+void FileGrowthWatcher::run()
+{
+    if(watchWithNotifications())
+        return;
+
+    auto lastSize = file.getSize();
+
+    while(! threadShouldExit()){
+
+        wait(250);
+
+        auto size = file.getSize();
+
+        if(size != lastSize){
+            lastSize = size;
+            onChange();
+        }
+    }
+}
+
+bool FileGrowthWatcher::watchWithNotifications()
+{
+   #if JUCE_LINUX
+    auto fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if(fd < 0)
+        return false;
+
+    if(inotify_add_watch(fd, file.getFullPathName().toRawUTF8(), IN_MODIFY | IN_CLOSE_WRITE) < 0){
+        close(fd);
+        return false;
+    }
+
+    while(! threadShouldExit()){
+
+        pollfd pfd{ fd, POLLIN, 0 };
+
+        //the timeout is only there so stopThread() gets noticed
+        if(poll(&pfd, 1, 250) <= 0)
+            continue;
+
+        //a busy writer queues up lots of events, one callback covers them all
+        char events[4096];
+        while(read(fd, events, sizeof(events)) > 0) {}
+
+        onChange();
+    }
+
+    close(fd);
+    return true;
+   #else
+    return false;
+   #endif
+}
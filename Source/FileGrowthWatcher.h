@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+
+    FileGrowthWatcher.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+
+//==============================================================================
+/**
+    Calls onChange on its own thread whenever a file is written to.
+
+    On Linux this blocks on inotify, so a recorder appending to the file wakes it
+    straight away and nothing runs while the file is idle. Elsewhere it falls back
+    to checking the file size four times a second.
+*/
+class FileGrowthWatcher  : private juce::Thread
+{
+public:
+    FileGrowthWatcher (const juce::File& file, std::function<void()> onChange);
+    ~FileGrowthWatcher() override;
+
+private:
+    void run() override;
+    bool watchWithNotifications();
+
+    juce::File file;
+    std::function<void()> onChange;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FileGrowthWatcher)
+};
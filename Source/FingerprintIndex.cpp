@@ -0,0 +1,637 @@
+/*
+  ==============================================================================
+
+    FingerprintIndex.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "FingerprintIndex.h"
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <unordered_map>
+
+#if JUCE_LINUX
+ #include <sys/resource.h>
+#endif
+
+namespace
+{
+    constexpr int readBlockSize = 65536;
+    constexpr int numBands = 7;
+    constexpr int bandEdges[numBands + 1] = { 5, 10, 20, 40, 80, 160, 320, 512 };//bins, 54 Hz to 5.5 kHz
+    constexpr float relativeThreshold = 0.05f;//a band peak under -26 dB of the frame's loudest is noise
+    constexpr float silence = 1.0e-4f;
+    constexpr int fanOut = 4;//pairs per anchor peak
+    constexpr juce::uint32 maxFrameDelta = 63;//six bits of the hash
+    constexpr size_t maxPostingsForDuplicates = 64;//longer lists are hashes everything has
+    constexpr size_t maxDuplicatePairs = 1 << 18;//pairs of files findDuplicates keeps votes for
+
+    struct Peak
+    {
+        juce::uint32 frame, bin;
+    };
+
+    struct BandPeak
+    {
+        int bin = 0;
+        float magnitude = 0.0f;
+    };
+
+    using FramePeaks = std::array<BandPeak, numBands>;
+
+    void writeVarint(std::vector<juce::uint8>& data, juce::uint32 value)
+    {
+        while(value >= 0x80){
+            data.push_back((juce::uint8) (value | 0x80));
+            value >>= 7;
+        }
+
+        data.push_back((juce::uint8) value);
+    }
+
+    juce::uint32 readVarint(const juce::uint8*& data)
+    {
+        juce::uint32 value = 0;
+
+        for(int shift = 0;; shift += 7){
+            auto byte = *data++;
+            value |= (juce::uint32) (byte & 0x7f) << shift;
+
+            if((byte & 0x80) == 0)
+                return value;
+        }
+    }
+
+    juce::uint64 pairKey(juce::uint32 a, juce::uint32 b)      { return ((juce::uint64) a << 32) | b; }
+
+    //votes keyed by file and offset. offsets are biased so negative ones fit
+    juce::uint64 voteKey(juce::uint32 file, juce::int64 offset) { return ((juce::uint64) file << 32) | (juce::uint32) (offset + 0x40000000); }
+
+    //the best offset, counting its neighbours too since peaks can land a frame either side
+    template <typename Map>
+    void bestAlignment(const Map& votes, juce::int64 key, int count, int& bestVotes, juce::int64& bestKey)
+    {
+        auto neighbour = [&](juce::int64 k){ auto found = votes.find((typename Map::key_type) k); return found != votes.end() ? found->second : 0; };
+        auto total = count + neighbour(key - 1) + neighbour(key + 1);
+
+        if(total > bestVotes){
+            bestVotes = total;
+            bestKey = key;
+        }
+    }
+
+    struct PairVotes
+    {
+        int total = 0;
+        std::unordered_map<juce::int64, int> offsets;
+    };
+
+    //most pairs share a hash or two by chance, and each costs a map. keys come in hash order, so a real
+    //duplicate's votes build up evenly over the pass: keep the pairs at half the pace to reach
+    //minimumVotes by the end, and raise the bar until only half of maxDuplicatePairs are left
+    void prunePairVotes(std::unordered_map<juce::uint64, PairVotes>& pairVotes, double fractionDone)
+    {
+        for(int threshold = juce::jmax(2, (int) (FingerprintIndex::minimumVotes * fractionDone / 2));
+            pairVotes.size() > maxDuplicatePairs / 2; threshold *= 2){
+
+            for(auto pair = pairVotes.begin(); pair != pairVotes.end();)
+                pair = pair->second.total < threshold ? pairVotes.erase(pair) : std::next(pair);
+        }
+    }
+
+    //union-find over file numbers
+    juce::uint32 findRoot(std::vector<juce::uint32>& parents, juce::uint32 file)
+    {
+        while(parents[file] != file)
+            file = parents[file] = parents[parents[file]];
+
+        return file;
+    }
+}
+
+//==============================================================================
+class FingerprintIndex::FingerprintJob  : public AnalysisPool::Job
+{
+public:
+    FingerprintJob(FingerprintIndex& o, const juce::File& f) : AnalysisPool::Job("Fingerprint", &o), owner(o), file(f) {}
+
+    JobStatus runJob() override
+    {
+       #if JUCE_LINUX
+        setpriority(PRIO_PROCESS, 0, 19);//as beat analysis: only what's left over
+       #endif
+
+        owner.runFingerprint(file, [this]{
+            owner.streams->waitWhileStreamsAreUrgent(500);
+            return shouldExit();
+        });
+
+        return jobHasFinished;
+    }
+
+private:
+    FingerprintIndex& owner;
+    juce::File file;
+};
+
+//==============================================================================
+FingerprintIndex::FingerprintIndex(juce::AudioFormatManager& fm)
+    : formatManager(fm)
+{
+}
+
+FingerprintIndex::~FingerprintIndex()
+{
+    pool->removeJobsFor(this, 5000);
+}
+
+void FingerprintIndex::addFile(const juce::File& file)
+{
+    auto path = file.getFullPathName();
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        if(fileNumbers.find(path) != fileNumbers.end() || pending.contains(path))
+            return;
+
+        pending.add(path);
+    }
+
+    pool->addJob(new FingerprintJob(*this, file));
+}
+
+void FingerprintIndex::addFolder(const juce::File& folder)
+{
+    for(auto& file : folder.findChildFiles(juce::File::findFiles, true, formatManager.getWildcardForAllFormats()))
+        addFile(file);
+}
+
+int FingerprintIndex::getNumPending() const
+{
+    const juce::ScopedLock sl(lock);
+    return pending.size();
+}
+
+int FingerprintIndex::getNumFiles() const
+{
+    const juce::ScopedLock sl(lock);
+    return files.size();
+}
+
+void FingerprintIndex::runFingerprint(const juce::File& file, const std::function<bool()>& shouldExit)
+{
+    std::vector<Hash> hashes;
+    bool found = readCache(file, hashes);
+
+    if(! found){
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+
+        if(reader != nullptr && extract(*reader, hashes, shouldExit)){
+            writeCache(file, hashes);
+            found = true;
+        }
+    }
+
+    bool shouldRebuild;
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        pending.removeString(file.getFullPathName());
+
+        if(found && fileNumbers.find(file.getFullPathName()) == fileNumbers.end()){
+
+            auto number = (juce::uint32) files.size();
+            files.add(file);
+            fileNumbers[file.getFullPathName()] = number;
+            hashCounts.push_back((juce::uint32) hashes.size());
+
+            for(auto& hash : hashes)
+                unindexed.push_back({ hash.hash, number, hash.frame });
+        }
+
+        shouldRebuild = ! unindexed.empty() && (pending.isEmpty() || unindexed.size() >= rebuildEntries);
+    }
+
+    if(shouldRebuild)
+        rebuild();
+
+    if(found)
+        sendChangeMessage();
+}
+
+//==============================================================================
+bool FingerprintIndex::extract(juce::AudioFormatReader& reader, std::vector<Hash>& result,
+                               const std::function<bool()>& shouldExit)
+{
+    result.clear();
+
+    if(reader.sampleRate <= 0.0 || reader.numChannels == 0 || reader.lengthInSamples <= 0)
+        return false;
+
+    const double ratio = reader.sampleRate / analysisRate;
+
+    //only needed going down. a file at or below analysisRate (phone audio, say) has nothing up there to alias
+    const bool downsampling = reader.sampleRate > analysisRate;
+    juce::IIRFilter antiAlias;
+
+    if(downsampling)
+        antiAlias.setCoefficients(juce::IIRCoefficients::makeLowPass(reader.sampleRate, analysisRate * 0.45));
+    juce::LagrangeInterpolator resampler;
+
+    juce::dsp::FFT fft(fftOrder);
+    juce::dsp::WindowingFunction<float> window((size_t) fftSize, juce::dsp::WindowingFunction<float>::hann, false);
+    std::vector<float> fftData((size_t) fftSize * 2);
+
+    juce::AudioBuffer<float> block((int) reader.numChannels, readBlockSize);
+    std::vector<float> mono, resampled;
+    size_t resampledStart = 0;//the next frame starts here
+
+    //peaks are only kept if they beat the same band in the frames either side
+    FramePeaks previous{}, current{}, next{};
+    juce::uint32 numFrames = 0;
+    std::vector<Peak> peaks;
+
+    auto analyseFrame = [&](const float* samples){
+
+        std::fill(fftData.begin(), fftData.end(), 0.0f);
+        std::copy(samples, samples + fftSize, fftData.begin());
+        window.multiplyWithWindowingTable(fftData.data(), (size_t) fftSize);
+        fft.performFrequencyOnlyForwardTransform(fftData.data());
+
+        previous = current;
+        current = next;
+        next = {};
+
+        float loudest = 0.0f;
+
+        for(int band = 0; band < numBands; ++band){
+            for(int bin = bandEdges[band]; bin < bandEdges[band + 1]; ++bin){
+                if(fftData[(size_t) bin] > next[(size_t) band].magnitude)
+                    next[(size_t) band] = { bin, fftData[(size_t) bin] };
+            }
+
+            loudest = juce::jmax(loudest, next[(size_t) band].magnitude);
+        }
+
+        for(auto& peak : next)
+            if(peak.magnitude < loudest * relativeThreshold || peak.magnitude < silence)
+                peak.magnitude = 0.0f;
+
+        //"current" now has both neighbours
+        if(numFrames >= 2){
+            for(int band = 0; band < numBands; ++band){
+                auto& peak = current[(size_t) band];
+
+                if(peak.magnitude > 0.0f && peak.magnitude >= previous[(size_t) band].magnitude && peak.magnitude >= next[(size_t) band].magnitude)
+                    peaks.push_back({ numFrames - 1, (juce::uint32) peak.bin });
+            }
+        }
+
+        ++numFrames;
+    };
+
+    for(juce::int64 position = 0; position < reader.lengthInSamples; position += readBlockSize){
+
+        if(shouldExit())
+            return false;
+
+        auto numSamples = (int) juce::jmin((juce::int64) readBlockSize, reader.lengthInSamples - position);
+        reader.read(&block, 0, numSamples, position, true, true);
+
+        auto gain = 1.0f / (float) block.getNumChannels();
+        auto oldSize = mono.size();
+        mono.resize(oldSize + (size_t) numSamples);
+
+        for(int i = 0; i < numSamples; ++i){
+            float sum = 0.0f;
+
+            for(int channel = 0; channel < block.getNumChannels(); ++channel)
+                sum += block.getSample(channel, i);
+
+            mono[oldSize + (size_t) i] = sum * gain;
+        }
+
+        if(downsampling)
+            antiAlias.processSamples(mono.data() + oldSize, numSamples);
+
+        //down to the analysis rate, keeping a couple of input samples back for the interpolator
+        auto numOut = (int) ((double) ((int) mono.size() - 2) / ratio);
+
+        if(numOut > 0){
+            auto outStart = resampled.size();
+            resampled.resize(outStart + (size_t) numOut);
+            auto used = resampler.process(ratio, mono.data(), resampled.data() + outStart, numOut);
+            mono.erase(mono.begin(), mono.begin() + juce::jmin((int) mono.size(), used));
+        }
+
+        for(; resampled.size() - resampledStart >= (size_t) fftSize; resampledStart += hopSize)
+            analyseFrame(resampled.data() + resampledStart);
+
+        resampled.erase(resampled.begin(), resampled.begin() + (std::ptrdiff_t) resampledStart);
+        resampledStart = 0;
+    }
+
+    //anchor each peak to the next few that follow it
+    for(size_t i = 0; i < peaks.size(); ++i){
+
+        int paired = 0;
+
+        for(size_t j = i + 1; j < peaks.size() && paired < fanOut; ++j){
+
+            auto delta = peaks[j].frame - peaks[i].frame;
+
+            if(delta == 0)
+                continue;
+
+            if(delta > maxFrameDelta)
+                break;
+
+            result.push_back({ (peaks[i].bin << 15) | (peaks[j].bin << 6) | delta, peaks[i].frame });
+            ++paired;
+        }
+    }
+
+    return ! result.empty();
+}
+
+//==============================================================================
+void FingerprintIndex::rebuild()
+{
+    //only one rebuild at a time, so the index can be read here without the lock: nothing else writes it
+    const juce::ScopedLock rl(rebuildLock);
+
+    std::vector<Entry> entries;
+
+    {
+        const juce::ScopedLock sl(lock);
+        entries.swap(unindexed);
+    }
+
+    if(entries.empty())
+        return;//another thread's rebuild took them
+
+    //everything back out of the compact form, merged with what's new, and packed again
+    entries.reserve(entries.size() + index.postingData.size() / 2);
+
+    for(size_t key = 0; key < index.keys.size(); ++key)
+        index.forEachPosting(key, [&](juce::uint32 file, juce::uint32 frame){ entries.push_back({ index.keys[key], file, frame }); });
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b){
+        return a.hash != b.hash ? a.hash < b.hash : (a.file != b.file ? a.file < b.file : a.frame < b.frame);
+    });
+
+    CompactIndex newIndex;
+    auto& newKeys = newIndex.keys;
+    auto& newStarts = newIndex.postingStarts;
+    auto& newData = newIndex.postingData;
+
+    for(size_t i = 0; i < entries.size();){
+
+        auto hash = entries[i].hash;
+        juce::uint32 lastFile = 0, lastFrame = 0;
+        bool first = true;
+
+        newKeys.push_back(hash);
+
+        //file as a delta from the last posting; frame as a delta too if the file is the same
+        for(; i < entries.size() && entries[i].hash == hash; ++i){
+
+            auto fileDelta = first ? entries[i].file : entries[i].file - lastFile;
+            writeVarint(newData, fileDelta);
+            writeVarint(newData, fileDelta == 0 && ! first ? entries[i].frame - lastFrame : entries[i].frame);
+
+            lastFile = entries[i].file;
+            lastFrame = entries[i].frame;
+            first = false;
+        }
+
+        newStarts.push_back(newData.size());
+    }
+
+    newData.shrink_to_fit();
+
+    const juce::ScopedLock sl(lock);
+    std::swap(index, newIndex);
+}
+
+template <typename Callback>
+void FingerprintIndex::CompactIndex::forEachPosting(size_t keyIndex, Callback&& callback) const
+{
+    const auto* data = postingData.data() + postingStarts[keyIndex];
+    const auto* end = postingData.data() + postingStarts[keyIndex + 1];
+
+    juce::uint32 file = 0, frame = 0;
+    bool first = true;
+
+    while(data < end){
+
+        auto fileDelta = readVarint(data);
+        auto frameValue = readVarint(data);
+
+        frame = (fileDelta == 0 && ! first) ? frame + frameValue : frameValue;
+        file += fileDelta;
+        first = false;
+
+        callback(file, frame);
+    }
+}
+
+//==============================================================================
+FingerprintIndex::Match FingerprintIndex::identify(const juce::File& clip)
+{
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(clip));
+    std::vector<Hash> hashes;
+
+    if(reader == nullptr || ! extract(*reader, hashes, []{ return false; }))
+        return {};
+
+    return identify(hashes);
+}
+
+FingerprintIndex::Match FingerprintIndex::identify(const std::vector<Hash>& clipHashes)
+{
+    const juce::ScopedLock sl(lock);//lookups only, the pool keeps the index up to date
+
+    std::unordered_map<juce::uint64, int> votes;
+
+    for(auto& clipHash : clipHashes){
+
+        auto found = std::lower_bound(index.keys.begin(), index.keys.end(), clipHash.hash);
+
+        if(found == index.keys.end() || *found != clipHash.hash)
+            continue;
+
+        index.forEachPosting((size_t) (found - index.keys.begin()), [&](juce::uint32 file, juce::uint32 frame){
+            ++votes[voteKey(file, (juce::int64) frame - (juce::int64) clipHash.frame)];
+        });
+    }
+
+    int bestVotes = 0;
+    juce::int64 bestKey = 0;
+
+    for(auto& vote : votes)
+        bestAlignment(votes, (juce::int64) vote.first, vote.second, bestVotes, bestKey);
+
+    Match match;
+
+    if(bestVotes < minimumVotes || clipHashes.empty())
+        return match;
+
+    auto file = (juce::uint32) ((juce::uint64) bestKey >> 32);
+    auto offsetFrames = (juce::int64) ((juce::uint64) bestKey & 0xffffffff) - 0x40000000;
+
+    match.file = files[(int) file];
+    match.offsetSeconds = (double) (offsetFrames * hopSize) / analysisRate;
+    match.similarity = juce::jmin(1.0, (double) bestVotes / (double) clipHashes.size());
+    match.votes = bestVotes;
+    return match;
+}
+
+std::vector<FingerprintIndex::DuplicateGroup> FingerprintIndex::findDuplicates()
+{
+    //voted over a copy, so lookups and files coming in don't wait for the whole pass. the compact
+    //form is a few bytes a posting, little next to the votes
+    CompactIndex snapshot;
+    juce::Array<juce::File> indexedFiles;
+    std::vector<juce::uint32> counts;
+
+    {
+        const juce::ScopedLock sl(lock);
+        snapshot = index;
+        indexedFiles = files;
+        counts = hashCounts;
+    }
+
+    //every pair of files sharing a hash votes for the offset between them
+    std::unordered_map<juce::uint64, PairVotes> pairVotes;
+    std::vector<std::pair<juce::uint32, juce::uint32>> postings;
+
+    for(size_t key = 0; key < snapshot.keys.size(); ++key){
+
+        postings.clear();
+        snapshot.forEachPosting(key, [&](juce::uint32 file, juce::uint32 frame){ postings.emplace_back(file, frame); });
+
+        if(postings.size() < 2 || postings.size() > maxPostingsForDuplicates)
+            continue;
+
+        for(size_t a = 0; a < postings.size(); ++a)
+            for(size_t b = a + 1; b < postings.size(); ++b)
+                if(postings[a].first != postings[b].first){//sorted by file, so a's is the lower
+                    auto& pair = pairVotes[pairKey(postings[a].first, postings[b].first)];
+                    ++pair.total;
+                    ++pair.offsets[(juce::int64) postings[b].second - (juce::int64) postings[a].second];
+                }
+
+        if(pairVotes.size() > maxDuplicatePairs)
+            prunePairVotes(pairVotes, (double) (key + 1) / (double) snapshot.keys.size());
+    }
+
+    std::vector<juce::uint32> parents((size_t) indexedFiles.size());
+
+    for(size_t i = 0; i < parents.size(); ++i)
+        parents[i] = (juce::uint32) i;
+
+    std::vector<std::pair<juce::uint64, double>> links;
+
+    for(auto& pair : pairVotes){
+
+        int bestVotes = 0;
+        juce::int64 bestOffset = 0;
+
+        for(auto& vote : pair.second.offsets)
+            bestAlignment(pair.second.offsets, vote.first, vote.second, bestVotes, bestOffset);
+
+        auto a = (juce::uint32) (pair.first >> 32);
+        auto b = (juce::uint32) (pair.first & 0xffffffff);
+
+        //the shorter file is the one that's (nearly) contained in the other
+        auto similarity = (double) bestVotes / (double) juce::jmax((juce::uint32) 1, juce::jmin(counts[a], counts[b]));
+
+        if(bestVotes >= minimumVotes && similarity >= nearDuplicateSimilarity)
+            links.emplace_back(pair.first, juce::jmin(1.0, similarity));
+    }
+
+    for(auto& link : links){
+        auto a = findRoot(parents, (juce::uint32) (link.first >> 32));
+        auto b = findRoot(parents, (juce::uint32) (link.first & 0xffffffff));
+        parents[b] = a;
+    }
+
+    std::map<juce::uint32, DuplicateGroup> groups;
+
+    for(auto& link : links){
+        auto root = findRoot(parents, (juce::uint32) (link.first >> 32));
+        auto& group = groups[root];
+        group.similarity = group.files.isEmpty() ? link.second : juce::jmin(group.similarity, link.second);
+        group.files.addIfNotAlreadyThere(indexedFiles[(int) (link.first >> 32)]);
+        group.files.addIfNotAlreadyThere(indexedFiles[(int) (link.first & 0xffffffff)]);
+    }
+
+    std::vector<DuplicateGroup> result;
+
+    for(auto& group : groups){
+        group.second.isExact = group.second.similarity >= duplicateSimilarity;
+        result.push_back(group.second);
+    }
+
+    std::sort(result.begin(), result.end(), [](const DuplicateGroup& a, const DuplicateGroup& b){ return a.similarity > b.similarity; });
+    return result;
+}
+
+//==============================================================================
+juce::File FingerprintIndex::getCacheFile(const juce::File& file)
+{
+    return file.getSiblingFile(file.getFileName() + ".fingerprint");
+}
+
+bool FingerprintIndex::readCache(const juce::File& file, std::vector<Hash>& result)
+{
+    juce::FileInputStream in(getCacheFile(file));
+
+    //only if it was made from the file as it is now
+    if(! in.openedOk() || in.readInt() != (int) juce::ByteOrder::littleEndianInt("MPFP")
+        || in.readInt64() != file.getSize()
+        || in.readInt64() != file.getLastModificationTime().toMilliseconds())
+        return false;
+
+    auto count = in.readInt();
+
+    if(count <= 0 || in.getNumBytesRemaining() != (juce::int64) count * 8)
+        return false;
+
+    result.resize((size_t) count);
+
+    for(auto& hash : result){
+        hash.hash = (juce::uint32) in.readInt();
+        hash.frame = (juce::uint32) in.readInt();
+    }
+
+    return true;
+}
+
+void FingerprintIndex::writeCache(const juce::File& file, const std::vector<Hash>& hashes)
+{
+    auto cacheFile = getCacheFile(file);
+    cacheFile.deleteFile();
+
+    juce::FileOutputStream out(cacheFile);
+
+    if(! out.openedOk())
+        return;//a read-only folder just means extracting again next time
+
+    out.writeInt((int) juce::ByteOrder::littleEndianInt("MPFP"));
+    out.writeInt64(file.getSize());
+    out.writeInt64(file.getLastModificationTime().toMilliseconds());
+    out.writeInt((int) hashes.size());
+
+    for(auto& hash : hashes){
+        out.writeInt((int) hash.hash);
+        out.writeInt((int) hash.frame);
+    }
+}
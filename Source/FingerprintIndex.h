@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    FingerprintIndex.h
+    Created: 19 Oct 2026
+
+    Acoustic fingerprints for a library: finds the same recording under other
+    names and formats, and which file a short clip was cut from.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <map>
+#include <vector>
+#include "AnalysisPool.h"
+#include "StreamScheduler.h"
+
+//==============================================================================
+/**
+    Fingerprints are spectral peak pairs. Each file is taken down to mono at
+    11025 Hz, the strongest bin of seven octave bands is kept wherever it is a
+    peak in time too, and every peak is paired with the next few after it. A pair
+    hashes to its two frequencies and the time between them, which survives
+    re-encoding, level changes and most EQ.
+
+    The inverted index maps each hash to the (file, frame) pairs it occurs at.
+    Keys are sorted for a binary search and each posting list is stored as
+    variable length deltas, a few bytes a posting. Matching is voting: postings
+    that agree on one time offset into one file are the same audio.
+
+    Extraction runs like BeatAnalyser: in the shared AnalysisPool at the lowest
+    priority, stepping aside for streams that are short, with results
+    cached in <file>.fingerprint. A change message goes out as files come in.
+
+    New files are folded into the index by the pool, whenever the queue runs dry
+    (and every rebuildEntries hashes on a long one), so lookups never wait for a
+    rebuild. A new file isn't found until the rebuild after it has finished.
+*/
+class FingerprintIndex  : public juce::ChangeBroadcaster
+{
+public:
+    static constexpr double analysisRate = 11025.0;
+    static constexpr int fftOrder = 10;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int hopSize = fftSize / 2;//46 ms
+
+    struct Hash
+    {
+        juce::uint32 hash;
+        juce::uint32 frame;//of the first peak in the pair
+    };
+
+    struct Match
+    {
+        juce::File file;
+        double offsetSeconds = 0.0;//where in file the clip starts
+        double similarity = 0.0;//aligned hashes over the clip's hashes
+        int votes = 0;
+
+        bool isValid() const            { return votes > 0; }
+    };
+
+    struct DuplicateGroup
+    {
+        juce::Array<juce::File> files;
+        double similarity = 0.0;//the weakest link in the group
+        bool isExact = false;//everything at or above duplicateSimilarity, otherwise a near-duplicate
+    };
+
+    static constexpr double duplicateSimilarity = 0.5;
+    static constexpr double nearDuplicateSimilarity = 0.1;
+    static constexpr int minimumVotes = 20;
+    static constexpr size_t rebuildEntries = 1 << 22;
+
+    explicit FingerprintIndex (juce::AudioFormatManager& formatManager);
+    ~FingerprintIndex() override;
+
+    /** Queues a file, unless it's indexed or already waiting. */
+    void addFile (const juce::File& file);
+
+    /** Queues every file in a folder (and below it) that formatManager can read. */
+    void addFolder (const juce::File& folder);
+
+    int getNumPending() const;
+    int getNumFiles() const;
+
+    /** Which indexed file the clip comes from, and where. Invalid if nothing agrees. */
+    Match identify (const juce::File& clip);
+    Match identify (const std::vector<Hash>& clipHashes);
+
+    /** Every group of files sharing enough aligned hashes, best first. */
+    std::vector<DuplicateGroup> findDuplicates();
+
+    /** The extraction itself. Returns false if there's no audio, or shouldExit said so. */
+    static bool extract (juce::AudioFormatReader& reader, std::vector<Hash>& result,
+                         const std::function<bool()>& shouldExit);
+
+private:
+    class FingerprintJob;
+
+    struct Entry
+    {
+        juce::uint32 hash, file, frame;
+    };
+
+    void runFingerprint (const juce::File& file, const std::function<bool()>& shouldExit);
+    void rebuild();//pool threads: folds unindexed entries into a new compact index and swaps it in
+
+    static juce::File getCacheFile (const juce::File& file);
+    static bool readCache (const juce::File& file, std::vector<Hash>& result);
+    static void writeCache (const juce::File& file, const std::vector<Hash>& hashes);
+
+    juce::AudioFormatManager& formatManager;
+    juce::SharedResourcePointer<AnalysisPool> pool;//the beat analysers' too
+    juce::SharedResourcePointer<StreamScheduler> streams;
+
+    juce::CriticalSection lock;
+    juce::StringArray pending;
+    juce::Array<juce::File> files;//index in here is the file number in postings
+    std::map<juce::String, juce::uint32> fileNumbers;//by full path
+    std::vector<juce::uint32> hashCounts;//per file
+    std::vector<Entry> unindexed;//added since the last rebuild, not found by lookups yet
+
+    //the compact index: postings for keys[i] are postingData[postingStarts[i] .. postingStarts[i + 1]).
+    //only rebuild() changes it, one at a time under rebuildLock, and only swaps it in under lock
+    struct CompactIndex
+    {
+        std::vector<juce::uint32> keys;
+        std::vector<size_t> postingStarts{0};
+        std::vector<juce::uint8> postingData;
+
+        template <typename Callback>
+        void forEachPosting (size_t keyIndex, Callback&& callback) const;
+    };
+
+    juce::CriticalSection rebuildLock;
+    CompactIndex index;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FingerprintIndex)
+};
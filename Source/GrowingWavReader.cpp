@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+    GrowingWavReader.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "GrowingWavReader.h"
+
+namespace
+{
+    enum
+    {
+        formatPCM = 1,
+        formatFloat = 3,
+        formatExtensible = 0xfffe
+    };
+
+    bool chunkIs(const char* id, const char* name)
+    {
+        return std::memcmp(id, name, 4) == 0;
+    }
+}
+
+GrowingWavReader* GrowingWavReader::open(const juce::File& file)
+{
+    std::unique_ptr<juce::FileInputStream> stream(file.createInputStream());
+
+    if(stream == nullptr || ! stream->openedOk())
+        return nullptr;
+
+    std::unique_ptr<GrowingWavReader> reader(new GrowingWavReader(file, stream.release()));
+
+    if(! reader->readHeader())
+        return nullptr;
+
+    reader->refresh();
+    reader->lengthInSamples = reader->getAvailableLength();
+    return reader.release();
+}
+
+GrowingWavReader::GrowingWavReader(const juce::File& f, juce::FileInputStream* stream)
+    : juce::AudioFormatReader(stream, "WAV file"), file(f)
+{
+    usesFloatingPointData = true;//readSamples() hands back floats whatever is on disk
+}
+
+bool GrowingWavReader::readHeader()
+{
+    char id[4];
+
+    if(input->read(id, 4) != 4 || ! chunkIs(id, "RIFF"))
+        return false;
+
+    input->readInt();//the RIFF size, not written yet while recording
+
+    if(input->read(id, 4) != 4 || ! chunkIs(id, "WAVE"))
+        return false;
+
+    bool gotFormat = false;
+
+    while(! input->isExhausted()){
+
+        if(input->read(id, 4) != 4)
+            return false;
+
+        auto chunkSize = (juce::uint32) input->readInt();
+        auto chunkStart = input->getPosition();
+
+        if(chunkIs(id, "fmt ")){
+
+            formatCode = (juce::uint16) input->readShort();
+            numChannels = (unsigned int) input->readShort();
+            sampleRate = input->readInt();
+            input->readInt();//bytes per second
+            bytesPerFrame = input->readShort();
+            bitsPerSample = (unsigned int) input->readShort();
+
+            if(formatCode == formatExtensible && chunkSize >= 40){
+                input->readShort();//cbSize
+                input->readShort();//valid bits
+                input->readInt();//channel mask
+                formatCode = (juce::uint16) input->readShort();//the first two bytes of the sub-format GUID
+            }
+
+            gotFormat = true;
+        }
+        else if(chunkIs(id, "data")){
+
+            //its size is a placeholder until the recorder finishes, so it's ignored
+            dataStart = chunkStart;
+            break;
+        }
+
+        input->setPosition(chunkStart + chunkSize + (chunkSize & 1));
+    }
+
+    if(! gotFormat || dataStart == 0 || numChannels == 0 || sampleRate <= 0)
+        return false;
+
+    auto supported = (formatCode == formatPCM && (bitsPerSample == 8 || bitsPerSample == 16
+                                                 || bitsPerSample == 24 || bitsPerSample == 32))
+                  || (formatCode == formatFloat && bitsPerSample == 32);
+
+    return supported && bytesPerFrame == (int) (numChannels * bitsPerSample / 8);
+}
+
+void GrowingWavReader::refresh()
+{
+    auto frames = juce::jmax((juce::int64) 0, (file.getSize() - dataStart) / bytesPerFrame);
+
+    //only ever grows: a recorder rewriting the header doesn't make the audio shorter
+    auto previous = availableLength.load();
+
+    while(frames > previous && ! availableLength.compare_exchange_weak(previous, frames)) {}
+}
+
+bool GrowingWavReader::readSamples(int** destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                                   juce::int64 startSampleInFile, int numSamples)
+{
+    lengthInSamples = availableLength.load();
+
+    clearSamplesBeyondAvailableLength(destChannels, numDestChannels, startOffsetInDestBuffer,
+                                      startSampleInFile, numSamples, lengthInSamples);
+
+    if(numSamples <= 0)
+        return true;
+
+    auto bytesNeeded = (size_t) numSamples * (size_t) bytesPerFrame;
+
+    if(rawDataSize < bytesNeeded){
+        rawData.realloc(bytesNeeded);
+        rawDataSize = bytesNeeded;
+    }
+
+    input->setPosition(dataStart + startSampleInFile * bytesPerFrame);
+    auto bytesRead = juce::jmax(0, input->read(rawData, (int) bytesNeeded));
+
+    //the size can run ahead of what has reached the disk, that part is silent for now
+    if((size_t) bytesRead < bytesNeeded)
+        std::memset(rawData + bytesRead, 0, bytesNeeded - (size_t) bytesRead);
+
+    auto bytesPerSample = (int) bitsPerSample / 8;
+
+    for(int channel = 0; channel < numDestChannels; ++channel){
+
+        if(destChannels[channel] == nullptr)
+            continue;
+
+        auto* dest = reinterpret_cast<float*>(destChannels[channel]) + startOffsetInDestBuffer;
+
+        if(channel >= (int) numChannels){
+            juce::FloatVectorOperations::clear(dest, numSamples);
+            continue;
+        }
+
+        auto* src = rawData.get() + channel * bytesPerSample;
+
+        for(int i = 0; i < numSamples; ++i, src += bytesPerFrame){
+
+            if(formatCode == formatFloat){
+                auto bits = juce::ByteOrder::littleEndianInt(src);
+                std::memcpy(dest + i, &bits, sizeof(float));
+            }
+            else if(bitsPerSample == 8){
+                dest[i] = ((float) (juce::uint8) *src - 128.0f) / 128.0f;
+            }
+            else if(bitsPerSample == 16){
+                dest[i] = (float) (juce::int16) juce::ByteOrder::littleEndianShort(src) / 32768.0f;
+            }
+            else if(bitsPerSample == 24){
+                dest[i] = (float) juce::ByteOrder::littleEndian24Bit(src) / 8388608.0f;
+            }
+            else{
+                dest[i] = (float) (juce::int32) juce::ByteOrder::littleEndianInt(src) / 2147483648.0f;
+            }
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    GrowingWavReader.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+//==============================================================================
+/**
+    Reads a WAV file that is still being written, e.g. a recording being ingested.
+
+    juce::WavAudioFormat takes the length from the header, which a recorder only
+    fills in when it's done. This reader takes it from the file size instead, and
+    refresh() picks up whatever has been appended since, without reopening the file.
+    Anything past what's on disk reads as silence.
+
+    Handles 8/16/24/32-bit PCM and 32-bit float, including WAVE_FORMAT_EXTENSIBLE.
+*/
+class GrowingWavReader  : public juce::AudioFormatReader
+{
+public:
+    /** Returns nullptr if the file isn't a WAV this can read. */
+    static GrowingWavReader* open (const juce::File& file);
+
+    /** Re-reads the file size. Safe to call from any thread. */
+    void refresh();
+
+    juce::int64 getAvailableLength() const noexcept     { return availableLength.load(); }
+
+    bool readSamples (int** destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                      juce::int64 startSampleInFile, int numSamples) override;
+
+private:
+    GrowingWavReader (const juce::File& file, juce::FileInputStream* stream);
+    bool readHeader();
+
+    juce::File file;
+    juce::int64 dataStart = 0;
+    int bytesPerFrame = 0;
+    int formatCode = 0;
+    std::atomic<juce::int64> availableLength{0};
+    juce::HeapBlock<char> rawData;
+    size_t rawDataSize = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GrowingWavReader)
+};
+
+//==============================================================================
+/**
+    An AudioFormatReaderSource whose length follows a GrowingWavReader as it grows.
+*/
+class GrowingFileReaderSource  : public juce::AudioFormatReaderSource
+{
+public:
+    GrowingFileReaderSource (GrowingWavReader* r, bool deleteReaderWhenThisIsDeleted)
+        : juce::AudioFormatReaderSource (r, deleteReaderWhenThisIsDeleted), reader (*r) {}
+
+    juce::int64 getTotalLength() const override     { return reader.getAvailableLength(); }
+
+private:
+    GrowingWavReader& reader;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GrowingFileReaderSource)
+};
@@ -0,0 +1,198 @@
+/*
+  ==============================================================================
+
+    ControlServer.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ControlServer.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    constexpr int maxLineLength = 4096;//a path and a command, anything longer is garbage
+
+    struct Client
+    {
+        int socket;
+        std::string pending;//bytes read since the last newline
+    };
+
+    void sendLine(int socket, const juce::String& reply)
+    {
+        auto line = reply + "\n";
+        auto* data = line.toRawUTF8();
+        auto remaining = line.getNumBytesAsUTF8();
+
+        while(remaining > 0){
+
+            auto sent = send(socket, data, remaining, MSG_NOSIGNAL);
+
+            if(sent <= 0)
+                return;//the client has gone, poll() will notice
+
+            data += sent;
+            remaining -= (size_t) sent;
+        }
+    }
+}
+
+ControlServer::ControlServer(const juce::String& path, Handler h)
+    : juce::Thread("MusicPlayer control"), socketPath(path), handler(std::move(h))
+{
+}
+
+void ControlServer::setSlowCommands(const juce::StringArray& commands, SlowHandler h)
+{
+    jassert(! isThreadRunning());
+
+    slowCommands = commands;
+    slowHandler = std::move(h);
+}
+
+ControlServer::~ControlServer()
+{
+    stopThread(2000);
+
+    if(listenSocket >= 0){
+        close(listenSocket);
+        unlink(socketPath.toRawUTF8());
+    }
+}
+
+juce::String ControlServer::start()
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+
+    if(socketPath.getNumBytesAsUTF8() >= sizeof(address.sun_path))
+        return "socket path too long: " + socketPath;
+
+    socketPath.copyToUTF8(address.sun_path, sizeof(address.sun_path));
+
+    listenSocket = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if(listenSocket < 0)
+        return "can't create socket: " + juce::String(strerror(errno));
+
+    unlink(address.sun_path);//left behind by a previous run that didn't exit cleanly
+
+    if(bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || listen(listenSocket, 8) != 0){
+
+        auto error = juce::String(strerror(errno));
+        close(listenSocket);
+        listenSocket = -1;
+        return "can't listen on " + socketPath + ": " + error;
+    }
+
+    chmod(address.sun_path, 0660);
+
+    startThread(3);
+    return {};
+}
+
+void ControlServer::run()
+{
+    std::vector<Client> clients;
+
+    while(! threadShouldExit()){
+
+        std::vector<pollfd> fds;
+        fds.push_back({ listenSocket, POLLIN, 0 });
+
+        for(auto& client : clients)
+            fds.push_back({ client.socket, POLLIN, 0 });
+
+        //the timeout is only there so stopThread() gets noticed
+        if(poll(fds.data(), (nfds_t) fds.size(), 250) <= 0)
+            continue;
+
+        if(fds[0].revents & POLLIN){
+
+            auto socket = accept4(listenSocket, nullptr, nullptr, SOCK_CLOEXEC);
+
+            if(socket >= 0)
+                clients.push_back({ socket, {} });
+        }
+
+        for(size_t i = 1; i < fds.size(); ++i){
+
+            if(fds[i].revents == 0)
+                continue;
+
+            auto& client = clients[i - 1];
+            char data[1024];
+            auto numRead = fds[i].revents & POLLIN ? recv(client.socket, data, sizeof(data), 0) : 0;
+
+            if(numRead <= 0 || client.pending.size() + (size_t) numRead > maxLineLength){
+                close(client.socket);
+                client.socket = -1;
+                continue;
+            }
+
+            client.pending.append(data, (size_t) numRead);
+
+            for(auto newline = client.pending.find('\n'); newline != std::string::npos; newline = client.pending.find('\n')){
+
+                auto line = juce::String::fromUTF8(client.pending.data(), (int) newline).trim();
+                client.pending.erase(0, newline + 1);
+
+                if(line.isNotEmpty())
+                    sendLine(client.socket, handleLine(line));
+            }
+        }
+
+        clients.erase(std::remove_if(clients.begin(), clients.end(), [](const Client& c){ return c.socket < 0; }), clients.end());
+    }
+
+    for(auto& client : clients)
+        close(client.socket);
+}
+
+juce::String ControlServer::handleLine(const juce::String& line)
+{
+    auto command = line.upToFirstOccurrenceOf(" ", false, false).toLowerCase();
+
+    if(slowHandler != nullptr && slowCommands.contains(command))
+        return slowHandler(line, [this]{ return threadShouldExit(); });
+
+    return handleOnMessageThread(line);
+}
+
+juce::String ControlServer::handleOnMessageThread(const juce::String& line)
+{
+    //shared, so a reply that comes in after we gave up on it has somewhere to go
+    struct Pending
+    {
+        juce::WaitableEvent done;
+        juce::String reply;
+    };
+
+    auto pending = std::make_shared<Pending>();
+    auto handlerCopy = handler;
+
+    juce::MessageManager::callAsync([pending, handlerCopy, line]
+    {
+        pending->reply = handlerCopy(line);
+        pending->done.signal();
+    });
+
+    if(! pending->done.wait(replyTimeoutMs))
+        return "ERR timed out";
+
+    return pending->reply;
+}
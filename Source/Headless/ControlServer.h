@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    ControlServer.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+
+//==============================================================================
+/**
+    A line based command protocol on a Unix domain socket.
+
+    Every line a client sends is one command. It's handed to the handler on the
+    message thread, and whatever the handler returns goes back as one line:
+    "OK ..." or "ERR ...". A reply that takes longer than replyTimeoutMs is
+    given up on. Any number of clients can be connected, e.g.
+
+        echo status | socat - UNIX-CONNECT:/tmp/musicplayer.sock
+
+    The socket is only as private as its folder: it's created 0660.
+*/
+class ControlServer  : private juce::Thread
+{
+public:
+    using Handler = std::function<juce::String (const juce::String& line)>;
+    using SlowHandler = std::function<juce::String (const juce::String& line, const std::function<bool()>& shouldExit)>;
+
+    ControlServer (const juce::String& socketPath, Handler handler);
+    ~ControlServer() override;
+
+    /** Commands (first words, lower case) too slow for the message thread and the
+        reply timeout. They run on the server's own thread instead, for as long as
+        they take, so commands from every client queue up behind them. shouldExit
+        goes true when the server is stopping. Call before start(). */
+    void setSlowCommands (const juce::StringArray& commands, SlowHandler slowHandler);
+
+    static constexpr int replyTimeoutMs = 5000;
+
+    /** Binds the socket and starts serving. Returns an error message, empty on success. */
+    juce::String start();
+
+private:
+    void run() override;
+    juce::String handleLine (const juce::String& line);
+    juce::String handleOnMessageThread (const juce::String& line);
+
+    juce::String socketPath;
+    Handler handler;
+    juce::StringArray slowCommands;
+    SlowHandler slowHandler;
+    int listenSocket = -1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ControlServer)
+};
@@ -0,0 +1,800 @@
+/*
+  ==============================================================================
+
+    HeadlessMain.cpp
+    Created: 19 Oct 2026
+
+    MusicPlayerHeadless: the processor on the default audio device with no editor,
+    for unattended playout. Build it from Builds/LinuxHeadless.
+
+        MusicPlayerHeadless [--socket=/tmp/musicplayer.sock] [--device=name]
+                            [--load=/path/to/file] [--play]
+                            [--rt] [--audio-cores=2,3] [--io-cores=1] [--io-priority=60]
+
+        MusicPlayerHeadless --rt-audit[=/path/to/file]
+
+    --rt-audit (Debug builds) plays a scripted session of loads, seeks, queueing,
+    volume and rate changes on a simulated audio thread with RealtimeAudit armed, and
+    exits non-zero if the audio thread allocated, locked or blocked even once.
+
+    Commands, one per line on the socket (see ControlServer):
+
+        load <path>     queue <path>    play    pause   stop
+        seek <seconds>  volume <0-1>    status  telemetry       quit
+        rate <-2 to 2>  (playback rate; below zero plays backwards)
+        rt              (what --rt / MUSICPLAYER_RT actually managed, see RealtimeHardening)
+        io              (the shared I/O scheduler: threads, and lead/underruns per stream)
+        storage <path>  (memory against expansion cost of each SampleStorage format, for the first
+                        residentClipSeconds of the file. runs on the socket's thread like decodebench)
+        fingerprint <folder or file>    (queue for FingerprintIndex; replies with files/pending)
+        duplicates      (duplicate and near-duplicate groups among fingerprinted files)
+        identify <path> (the fingerprinted file a clip comes from, its offset, and the lookup time)
+        decodebench <path>  (full decode: one sequential reader against ParallelDecoder on 1, 2, 4..
+                        threads, with the largest difference from the sequential decode. runs on
+                        the socket's thread, off the message thread and without the reply timeout,
+                        so other commands wait until it's done. it holds two full float copies of
+                        the file, 8 bytes a stereo sample each: 10 minutes at 44.1 kHz is 420 MB)
+        precisionbench <path>   (a second processor playing the file, processBlock timed with float
+                        and then double buffers: the best of five passes over a second of audio
+                        already in the read-ahead, in ms. runs on the socket's thread like decodebench)
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+#include "../FingerprintIndex.h"
+#include "../ParallelDecoder.h"
+#include "ControlServer.h"
+#include "RealtimeAudit.h"
+#include <atomic>
+#include <cmath>
+#include <csignal>
+#include <iostream>
+#include <limits>
+
+#if JUCE_LINUX
+ #include <unistd.h>
+#endif
+
+namespace
+{
+    std::atomic<bool> quitRequested{false};
+
+    void requestQuit(int)
+    {
+        quitRequested = true;//all a signal handler may do, a timer picks it up
+    }
+
+    //resident memory, which is what a machine full of playout processes runs out of
+    double getResidentMegabytes()
+    {
+       #if JUCE_LINUX
+        auto fields = juce::StringArray::fromTokens(juce::File("/proc/self/statm").loadFileAsString(), true);
+
+        if(fields.size() > 1)
+            return fields[1].getLargeIntValue() * (double) sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+       #endif
+
+        return 0.0;
+    }
+}
+
+//==============================================================================
+/**
+    Stands in for the device's audio thread: prepares the processor and calls
+    processBlock at real-time pace, each call inside a ScopedAudioThread.
+*/
+class OfflineAudioThread  : public juce::Thread
+{
+public:
+    OfflineAudioThread(juce::AudioProcessor& p, double rate, int size)
+        : juce::Thread("MusicPlayer offline audio"), processor(p), sampleRate(rate), blockSize(size)
+    {
+        processor.setPlayConfigDetails(0, 2, sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+    }
+
+    ~OfflineAudioThread() override
+    {
+        stopThread(2000);
+        processor.releaseResources();
+    }
+
+    int getNumBlocks() const noexcept    { return numBlocks.load(); }
+
+private:
+    void run() override
+    {
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midi;
+        const double blockMs = 1000.0 * blockSize / sampleRate;
+        auto due = juce::Time::getMillisecondCounterHiRes();
+
+        while(! threadShouldExit()){
+
+            {
+                RealtimeAudit::ScopedAudioThread audioThread;
+                processor.processBlock(buffer, midi);
+            }
+
+            ++numBlocks;
+            due += blockMs;
+
+            auto wait = due - juce::Time::getMillisecondCounterHiRes();
+
+            if(wait > 1.0)
+                juce::Thread::sleep((int) wait);
+        }
+    }
+
+    juce::AudioProcessor& processor;
+    const double sampleRate;
+    const int blockSize;
+    std::atomic<int> numBlocks{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OfflineAudioThread)
+};
+
+//==============================================================================
+class PlayoutDaemon  : private juce::Timer
+{
+public:
+    PlayoutDaemon() = default;
+
+    ~PlayoutDaemon() override
+    {
+        stopTimer();
+        server = nullptr;//no commands once we start taking things down
+        offlineAudio = nullptr;
+
+        deviceManager.removeAudioCallback(&player);
+        player.setProcessor(nullptr);
+        deviceManager.closeAudioDevice();
+    }
+
+    juce::String start(const juce::String& socketPath, const juce::String& deviceName)
+    {
+        auto error = deviceManager.initialise(0, 2, nullptr, true, deviceName, nullptr);
+
+        if(error.isNotEmpty())
+            return error;
+
+        if(deviceManager.getCurrentAudioDevice() == nullptr)
+            return "no audio device";
+
+        player.setProcessor(&processor);
+        deviceManager.addAudioCallback(&player);
+
+        server.reset(new ControlServer(socketPath, [this](const juce::String& line){ return handleCommand(line); }));
+
+        server->setSlowCommands({ "decodebench", "precisionbench", "storage" }, [this](const juce::String& line, const std::function<bool()>& shouldExit){
+
+            auto command = line.upToFirstOccurrenceOf(" ", false, false).toLowerCase();
+            auto argument = line.fromFirstOccurrenceOf(" ", false, false).trim();
+
+            if(command == "decodebench")
+                return benchmarkDecode(argument, shouldExit);
+
+            if(command == "precisionbench")
+                return benchmarkPrecision(argument, shouldExit);
+
+            return describeStorage(argument);
+        });
+
+        error = server->start();
+
+        if(error.isNotEmpty())
+            return error;
+
+        startedAt = juce::Time::getMillisecondCounterHiRes();
+        startTimer(200);
+        return {};
+    }
+
+    /** No device and no socket: the processor runs on an OfflineAudioThread. */
+    void startOffline(double sampleRate, int blockSize)
+    {
+        offlineAudio.reset(new OfflineAudioThread(processor, sampleRate, blockSize));
+        offlineAudio->startThread(8);
+        startedAt = juce::Time::getMillisecondCounterHiRes();
+    }
+
+    int getNumOfflineBlocks() const      { return offlineAudio != nullptr ? offlineAudio->getNumBlocks() : 0; }
+
+    /** Message thread, after start() so the audio thread is already running. */
+    void harden(const RealtimeHardening::Options& options)
+    {
+        processor.enableHardening(options);
+    }
+
+    /** Message thread. */
+    juce::String handleCommand(const juce::String& line)
+    {
+        auto command = line.upToFirstOccurrenceOf(" ", false, false).toLowerCase();
+        auto argument = line.fromFirstOccurrenceOf(" ", false, false).trim();
+
+        if(command == "load" || command == "queue"){
+
+            if(! juce::File::isAbsolutePath(argument))
+                return "ERR needs an absolute path";
+
+            juce::File file(argument);
+
+            if(! file.existsAsFile())
+                return "ERR no such file: " + argument;
+
+            if(command == "queue"){
+                processor.enqueueFile(file);
+                return "OK queued=" + juce::String(processor.getQueue().size());
+            }
+
+            processor.loadAudioFile(file);
+            return processor.fileLoaded ? "OK length=" + juce::String(processor.transport.getLengthInSeconds(), 2)
+                                        : "ERR can't read " + argument;
+        }
+
+        if(command == "play"){
+
+            if(! processor.fileLoaded)
+                return "ERR nothing loaded";
+
+            processor.changeTransportState(MusicPlayerAudioProcessor::starting);
+            return "OK";
+        }
+
+        if(command == "pause"){
+            processor.changeTransportState(MusicPlayerAudioProcessor::pausing);
+            return "OK";
+        }
+
+        if(command == "stop"){
+            processor.changeTransportState(MusicPlayerAudioProcessor::stopping);
+            return "OK";
+        }
+
+        if(command == "seek"){
+
+            if(! argument.containsOnly("0123456789.") || argument.isEmpty())
+                return "ERR seek <seconds>";
+
+            processor.transport.setPosition(juce::jlimit(0.0, processor.transport.getLengthInSeconds(), argument.getDoubleValue()));
+            return "OK position=" + juce::String(processor.transport.getCurrentPosition(), 3);
+        }
+
+        if(command == "volume"){
+
+            if(! argument.containsOnly("0123456789.") || argument.isEmpty())
+                return "ERR volume <0-1>";
+
+            auto* volume = processor.apvts.getParameter("VOL");
+            volume->setValueNotifyingHost(volume->convertTo0to1(juce::jlimit(0.0f, 1.0f, argument.getFloatValue())));
+            return "OK";
+        }
+
+        if(command == "rate"){
+
+            if(! argument.containsOnly("-0123456789.") || argument.isEmpty())
+                return "ERR rate <-2 to 2>";
+
+            auto* rate = processor.apvts.getParameter("RATE");
+            rate->setValueNotifyingHost(rate->convertTo0to1(juce::jlimit(-2.0f, 2.0f, argument.getFloatValue())));
+            return "OK rate=" + juce::String(processor.apvts.getRawParameterValue("RATE")->load(), 2);
+        }
+
+        if(command == "status")
+            return getStatus();
+
+        if(command == "telemetry")
+            return getTelemetry();
+
+        if(command == "rt")
+            return "OK " + processor.hardening.getReport();
+
+        if(command == "io")
+            return "OK " + processor.getStreamReport();
+
+        if(command == "fingerprint" || command == "duplicates" || command == "identify")
+            return handleFingerprintCommand(command, argument);
+
+        if(command == "quit"){
+            quitRequested = true;
+            return "OK";
+        }
+
+        return "ERR unknown command: " + command;
+    }
+
+private:
+    juce::String getStatus() const
+    {
+        static const char* stateNames[] = { "stopped", "starting", "playing", "stopping", "pausing", "paused" };
+
+        return juce::String("OK state=") + stateNames[(int) processor.state]
+             + " position=" + juce::String(processor.transport.getCurrentPosition(), 3)
+             + " length=" + juce::String(processor.transport.getLengthInSeconds(), 3)
+             + " volume=" + juce::String(processor.apvts.getRawParameterValue("VOL")->load(), 2)
+             + " queued=" + juce::String(processor.getQueue().size())
+             + " file=" + processor.currentlyLoadedFile.getFullPathName().quoted();
+    }
+
+    juce::String getTelemetry()
+    {
+        juce::String reply("OK");
+        reply << " cpu=" << juce::String(deviceManager.getCpuUsage(), 4);
+
+        if(auto* device = deviceManager.getCurrentAudioDevice()){
+            reply << " xruns=" << device->getXRunCount()
+                  << " rate=" << device->getCurrentSampleRate()
+                  << " block=" << device->getCurrentBufferSizeSamples()
+                  << " latency=" << (device->getOutputLatencyInSamples() + device->getCurrentBufferSizeSamples());
+        }
+
+        reply << " buffered=" << juce::String(processor.getBufferedSeconds(), 3)
+              << " limiterGR=" << juce::String(processor.limiter.getGainReductionDecibels(), 2)
+              << " pluginLatency=" << processor.getLatencySamples()
+              << " rss=" << juce::String(getResidentMegabytes(), 1)
+              << " uptime=" << juce::String((juce::Time::getMillisecondCounterHiRes() - startedAt) / 1000.0, 1);
+
+        return reply;
+    }
+
+    /** The control server's thread, like benchmarkDecode: it decodes up to residentClipSeconds. */
+    juce::String describeStorage(const juce::String& path)
+    {
+        if(! juce::File::isAbsolutePath(path))
+            return "ERR needs an absolute path";
+
+        std::unique_ptr<juce::AudioFormatReader> reader(processor.formatManager.createReaderFor(juce::File(path)));
+
+        if(reader == nullptr)
+            return "ERR can't read " + path;
+
+        //a resident clip's worth, from the start
+        auto numSamples = (int) juce::jmin(reader->lengthInSamples, (juce::int64) (TrackChain::residentClipSeconds * reader->sampleRate));
+        juce::AudioBuffer<float> audio(2, numSamples);
+        reader->read(&audio, 0, numSamples, 0, true, true);
+
+        return "OK " + SampleStorage::describeFormats(audio);
+    }
+
+    /** The control server's thread: far too slow for the message thread. */
+    juce::String benchmarkDecode(const juce::String& path, const std::function<bool()>& shouldExit)
+    {
+        if(! juce::File::isAbsolutePath(path))
+            return "ERR needs an absolute path";
+
+        juce::File file(path);
+        std::unique_ptr<juce::AudioFormatReader> reader(processor.formatManager.createReaderFor(file));
+
+        if(reader == nullptr)
+            return "ERR can't read " + path;
+
+        if(reader->lengthInSamples > std::numeric_limits<int>::max())
+            return "ERR too long to decode into one buffer";
+
+        //the baseline: what a single createReaderFor reader does, start to end. in blocks,
+        //the same size as ParallelDecoder's, so a server shutting down doesn't wait for it
+        auto length = (int) reader->lengthInSamples;
+        juce::AudioBuffer<float> sequential(2, length);
+
+        auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+        for(int position = 0; position < length; position += 65536){
+
+            if(shouldExit())
+                return "ERR stopped";
+
+            reader->read(&sequential, position, juce::jmin(65536, length - position), position, true, true);
+        }
+
+        auto sequentialSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+
+        juce::String reply("OK");
+        reply << " length=" << juce::String(length / reader->sampleRate, 1)
+              << " sequential=" << juce::String(sequentialSeconds, 3);
+
+        juce::AudioBuffer<float> parallel;
+        auto numCpus = juce::SystemStats::getNumCpus();
+        float maxError = 0.0f;
+        int realigned = 0, unmatched = 0;
+
+        for(int numThreads = 1;; numThreads = juce::jmin(numThreads * 2, numCpus)){
+
+            auto result = ParallelDecoder::decode(processor.formatManager, file, parallel, numThreads, shouldExit);
+
+            if(shouldExit())
+                return "ERR stopped";
+
+            if(! result.ok)
+                return "ERR parallel decode failed with " + juce::String(numThreads) + " threads";
+
+            for(int channel = 0; channel < 2; ++channel){
+                auto* a = sequential.getReadPointer(channel);
+                auto* b = parallel.getReadPointer(channel);
+
+                for(int i = 0; i < length; ++i)
+                    maxError = juce::jmax(maxError, std::abs(a[i] - b[i]));
+            }
+
+            realigned = juce::jmax(realigned, result.realignedEdges);
+            unmatched = juce::jmax(unmatched, result.unmatchedEdges);
+
+            reply << " threads" << result.numThreads << "=" << juce::String(result.seconds, 3)
+                  << "(x" << juce::String(sequentialSeconds / juce::jmax(1.0e-6, result.seconds), 2) << ")";
+
+            if(numThreads >= numCpus)
+                break;
+        }
+
+        reply << " maxError=" << juce::String(maxError, 8) << " realigned=" << realigned << " unmatched=" << unmatched;
+        return reply;
+    }
+
+    /** The control server's thread, like benchmarkDecode. */
+    juce::String benchmarkPrecision(const juce::String& path, const std::function<bool()>& shouldExit)
+    {
+        if(! juce::File::isAbsolutePath(path))
+            return "ERR needs an absolute path";
+
+        juce::File file(path);
+
+        if(! file.existsAsFile())
+            return "ERR no such file: " + path;
+
+        //a processor of its own, so what's playing isn't touched. it's made, loaded, prepared and
+        //freed on the message thread like any other, and this thread is its audio thread. no beat
+        //analysis: a file it hasn't seen would be decoded in the pool while the passes are timed
+        auto bench = std::make_shared<Bench>();
+
+        auto made = onBenchMessageThread(bench, [file](std::unique_ptr<MusicPlayerAudioProcessor>& processor){
+
+            processor.reset(new MusicPlayerAudioProcessor());
+            processor->beatAnalyser.setEnabled(false);
+            processor->loadAudioFile(file);
+
+            if(processor->fileLoaded)
+                processor->changeTransportState(MusicPlayerAudioProcessor::starting);
+        }, shouldExit);
+
+        auto reply = made ? timePrecisions(bench, path, shouldExit) : juce::String("ERR stopped");
+
+        juce::MessageManager::callAsync([bench]{ bench->processor = nullptr; });
+        return reply;
+    }
+
+    struct Bench
+    {
+        juce::WaitableEvent done;
+        std::unique_ptr<MusicPlayerAudioProcessor> processor;
+    };
+
+    /** Runs call on the message thread and waits for it. False if shouldExit said so first;
+        the call still happens, and bench lives until it has. */
+    static bool onBenchMessageThread(std::shared_ptr<Bench> bench,
+                                     std::function<void(std::unique_ptr<MusicPlayerAudioProcessor>&)> call,
+                                     const std::function<bool()>& shouldExit)
+    {
+        bench->done.reset();
+
+        juce::MessageManager::callAsync([bench, call]{
+            call(bench->processor);
+            bench->done.signal();
+        });
+
+        while(! bench->done.wait(100))
+            if(shouldExit())
+                return false;
+
+        return true;
+    }
+
+    static juce::String timePrecisions(std::shared_ptr<Bench> bench, const juce::String& path, const std::function<bool()>& shouldExit)
+    {
+        if(! bench->processor->fileLoaded)
+            return "ERR can't read " + path;
+
+        const double sampleRate = 48000.0;
+        const int blockSize = 512;
+        const int numBlocks = (int) (sampleRate / blockSize);//a second, well inside the read-ahead
+        const int numPasses = 5;
+
+        double best[2] = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+
+        for(int precision = 0; precision < 2; ++precision){
+
+            //the precision can only change while released, as a host would do it
+            auto prepared = onBenchMessageThread(bench, [=](std::unique_ptr<MusicPlayerAudioProcessor>& processor){
+
+                processor->releaseResources();
+                processor->setProcessingPrecision(precision == 0 ? juce::AudioProcessor::singlePrecision : juce::AudioProcessor::doublePrecision);
+                processor->setPlayConfigDetails(0, 2, sampleRate, blockSize);
+                processor->prepareToPlay(sampleRate, blockSize);
+            }, shouldExit);
+
+            if(! prepared)
+                return "ERR stopped";
+
+            for(int pass = 0; pass < numPasses; ++pass){
+
+                if(shouldExit())
+                    return "ERR stopped";
+
+                auto seconds = precision == 0 ? timeProcessBlock<float>(*bench->processor, numBlocks, blockSize)
+                                              : timeProcessBlock<double>(*bench->processor, numBlocks, blockSize);
+                best[precision] = juce::jmin(best[precision], seconds);
+            }
+        }
+
+        onBenchMessageThread(bench, [](std::unique_ptr<MusicPlayerAudioProcessor>& processor){ processor->releaseResources(); }, shouldExit);
+
+        juce::String reply("OK");
+        reply << " blocks=" << numBlocks << "x" << blockSize
+              << " float=" << juce::String(best[0] * 1000.0, 3)
+              << " double=" << juce::String(best[1] * 1000.0, 3)
+              << " ratio=" << juce::String(best[1] / juce::jmax(1.0e-9, best[0]), 3);
+
+        return reply;
+    }
+
+    template <typename FloatType>
+    static double timeProcessBlock(MusicPlayerAudioProcessor& bench, int numBlocks, int blockSize)
+    {
+        //from the start each time, once the read-ahead holds the whole pass: it's the processing
+        //that's timed, not the decoding
+        auto passSeconds = juce::jmin(numBlocks * blockSize / bench.getSampleRate(), bench.transport.getLengthInSeconds());
+        juce::AudioBuffer<FloatType> buffer(2, blockSize);
+        juce::MidiBuffer midi;
+
+        //the transport makes the seek at the top of a block, untimed, and the read-ahead refills after it
+        bench.transport.setPosition(0.0);
+        bench.processBlock(buffer, midi);
+
+        for(int tries = 0; tries < 400 && bench.getBufferedSeconds() < passSeconds; ++tries)
+            juce::Thread::sleep(5);
+
+        auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+        for(int i = 0; i < numBlocks; ++i)
+            bench.processBlock(buffer, midi);
+
+        return (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    }
+
+    juce::String handleFingerprintCommand(const juce::String& command, const juce::String& path)
+    {
+        if(command == "duplicates"){
+
+            juce::StringArray groups;
+
+            for(auto& group : fingerprints.findDuplicates()){
+
+                juce::StringArray names;
+
+                for(auto& file : group.files)
+                    names.add(file.getFullPathName().quoted());
+
+                groups.add(juce::String(group.isExact ? "duplicate" : "near") + " similarity=" + juce::String(group.similarity, 2)
+                           + " " + names.joinIntoString(" "));
+            }
+
+            return "OK groups=" + juce::String(groups.size()) + " pending=" + juce::String(fingerprints.getNumPending())
+                 + (groups.isEmpty() ? juce::String() : " | " + groups.joinIntoString(" | "));
+        }
+
+        if(! juce::File::isAbsolutePath(path))
+            return "ERR needs an absolute path";
+
+        juce::File file(path);
+
+        if(command == "fingerprint"){
+
+            if(file.isDirectory())
+                fingerprints.addFolder(file);
+            else if(file.existsAsFile())
+                fingerprints.addFile(file);
+            else
+                return "ERR no such file: " + path;
+
+            return "OK files=" + juce::String(fingerprints.getNumFiles()) + " pending=" + juce::String(fingerprints.getNumPending());
+        }
+
+        if(! file.existsAsFile())
+            return "ERR no such file: " + path;
+
+        auto startTime = juce::Time::getMillisecondCounterHiRes();
+        auto match = fingerprints.identify(file);
+        auto elapsed = juce::Time::getMillisecondCounterHiRes() - startTime;//extraction and lookup both
+
+        if(! match.isValid())
+            return "OK match=none ms=" + juce::String(elapsed, 1);
+
+        return "OK match=" + match.file.getFullPathName().quoted()
+             + " offset=" + juce::String(match.offsetSeconds, 2)
+             + " similarity=" + juce::String(match.similarity, 2)
+             + " votes=" + juce::String(match.votes)
+             + " ms=" + juce::String(elapsed, 1);
+    }
+
+    void timerCallback() override
+    {
+        if(quitRequested)
+            juce::MessageManager::getInstance()->stopDispatchLoop();
+    }
+
+    juce::AudioDeviceManager deviceManager;
+    juce::AudioProcessorPlayer player;
+    MusicPlayerAudioProcessor processor;
+    FingerprintIndex fingerprints{processor.formatManager};
+    std::unique_ptr<ControlServer> server;
+    std::unique_ptr<OfflineAudioThread> offlineAudio;
+    double startedAt = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PlayoutDaemon)
+};
+
+//==============================================================================
+/**
+    --rt-audit: one command every stepMs against an offline daemon with the
+    audit armed. Blank steps just let it play.
+*/
+class AuditSession  : private juce::Timer
+{
+public:
+    static constexpr int stepMs = 250;
+
+    AuditSession(PlayoutDaemon& d, const juce::File& f) : daemon(d), file(f)
+    {
+        auto path = file.getFullPathName();
+
+        script = { "load " + path, "play", "", "volume 0.2", "seek 12.5", "", "volume 0.9",
+                   "rate -1", "", "rate -1.7", "", "rate 0.6", "", "rate 1",
+                   "queue " + path, "seek 40", "", "", "", "pause", "play", "seek 3", "",
+                   "load " + path, "play", "", "volume 0.5", "stop", "play", "", "stop" };
+    }
+
+    void start()
+    {
+        RealtimeAudit::arm();
+        startTimer(stepMs);
+    }
+
+    int getExitCode() const noexcept     { return exitCode; }
+
+private:
+    void timerCallback() override
+    {
+        if(step < script.size()){
+
+            auto command = script[step++];
+
+            if(command.isNotEmpty())
+                std::cout << "rt-audit: " << command << " -> " << daemon.handleCommand(command) << std::endl;
+
+            return;
+        }
+
+        stopTimer();
+        RealtimeAudit::disarm();
+
+        auto violations = RealtimeAudit::getNumViolations();
+        std::cout << "rt-audit: " << violations << " violations in " << daemon.getNumOfflineBlocks() << " blocks" << std::endl;
+
+        exitCode = violations == 0 && daemon.getNumOfflineBlocks() > 0 ? 0 : 1;
+        juce::MessageManager::getInstance()->stopDispatchLoop();
+    }
+
+    PlayoutDaemon& daemon;
+    const juce::File file;
+    juce::StringArray script;
+    int step = 0;
+    int exitCode = 1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AuditSession)
+};
+
+//==============================================================================
+namespace
+{
+    //45 seconds so the session streams through the read-ahead rather than a resident clip
+    juce::File writeAuditFile()
+    {
+        const double sampleRate = 44100.0;
+        juce::AudioBuffer<float> audio(2, (int) (45.0 * sampleRate));
+
+        for(int i = 0; i < audio.getNumSamples(); ++i){
+            auto t = i / sampleRate;
+            auto sample = (float) (0.5 * std::sin(juce::MathConstants<double>::twoPi * 440.0 * t) * (0.6 + 0.4 * std::sin(juce::MathConstants<double>::twoPi * 2.0 * t)));
+            audio.setSample(0, i, sample);
+            audio.setSample(1, i, sample);
+        }
+
+        auto file = juce::File::createTempFile(".wav");
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(new juce::FileOutputStream(file), sampleRate, 2, 16, {}, 0));
+
+        if(writer == nullptr)
+            return {};
+
+        writer->writeFromAudioSampleBuffer(audio, 0, audio.getNumSamples());
+        return file;
+    }
+
+    int runAudit(const juce::ArgumentList& args)
+    {
+        if(! RealtimeAudit::isAvailable()){
+            std::cerr << "MusicPlayerHeadless: built without the real-time audit, use a Debug build" << std::endl;
+            return 2;
+        }
+
+        auto path = args.getValueForOption("--rt-audit");
+        auto file = path.isNotEmpty() ? juce::File(path) : writeAuditFile();
+
+        if(! file.existsAsFile()){
+            std::cerr << "MusicPlayerHeadless: nothing to play for the audit" << std::endl;
+            return 2;
+        }
+
+        int exitCode = 1;
+
+        {
+            PlayoutDaemon daemon;
+            daemon.startOffline(48000.0, 512);
+
+            AuditSession session(daemon, file);
+            session.start();
+            juce::MessageManager::getInstance()->runDispatchLoop();
+            exitCode = session.getExitCode();
+        }
+
+        if(path.isEmpty())
+            file.deleteFile();
+
+        return exitCode;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    auto socketPath = args.getValueForOption("--socket");
+
+    if(socketPath.isEmpty())
+        socketPath = "/tmp/musicplayer.sock";
+
+    //the message loop, without ever opening a window
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    if(args.containsOption("--rt-audit"))
+        return runAudit(args);
+
+    auto daemon = std::make_unique<PlayoutDaemon>();
+    auto error = daemon->start(socketPath, args.getValueForOption("--device"));
+
+    if(error.isNotEmpty()){
+        std::cerr << "MusicPlayerHeadless: " << error << std::endl;
+        return 1;
+    }
+
+    daemon->harden(RealtimeHardening::Options::fromArguments(args, RealtimeHardening::Options::fromEnvironment()));
+    std::cout << daemon->handleCommand("rt") << std::endl;
+
+    auto toLoad = args.getValueForOption("--load");
+
+    if(toLoad.isNotEmpty())
+        std::cout << daemon->handleCommand("load " + toLoad) << std::endl;
+
+    if(args.containsOption("--play"))
+        std::cout << daemon->handleCommand("play") << std::endl;
+
+    std::signal(SIGINT, requestQuit);
+    std::signal(SIGTERM, requestQuit);
+
+    std::cout << "MusicPlayerHeadless listening on " << socketPath << std::endl;
+    juce::MessageManager::getInstance()->runDispatchLoop();
+
+    daemon = nullptr;
+    return 0;
+}
@@ -0,0 +1,194 @@
+/*
+  ==============================================================================
+
+    RealtimeAudit.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "RealtimeAudit.h"
+#include <atomic>
+
+#if MUSICPLAYER_RT_AUDIT && JUCE_LINUX
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+//glibc's own entry points, so the allocator wrappers never need dlsym
+extern "C"
+{
+    void* __libc_malloc (size_t);
+    void* __libc_calloc (size_t, size_t);
+    void* __libc_realloc (void*, size_t);
+    void* __libc_memalign (size_t, size_t);
+    void __libc_free (void*);
+}
+
+namespace
+{
+    std::atomic<bool> armed{false};
+    std::atomic<int> violations{0};
+
+    //initial-exec TLS in the executable, reading these never allocates
+    thread_local int audioThreadDepth = 0;
+    thread_local bool reporting = false;
+
+    //the real ones, looked up once in resolve() so the lookup itself isn't reported
+    int (*realMutexLock)(pthread_mutex_t*) = nullptr;
+    int (*realCondWait)(pthread_cond_t*, pthread_mutex_t*) = nullptr;
+    int (*realCondTimedWait)(pthread_cond_t*, pthread_mutex_t*, const struct timespec*) = nullptr;
+    int (*realNanosleep)(const struct timespec*, struct timespec*) = nullptr;
+    int (*realUsleep)(useconds_t) = nullptr;
+    ssize_t (*realRead)(int, void*, size_t) = nullptr;
+    ssize_t (*realWrite)(int, const void*, size_t) = nullptr;
+
+    template <typename Function>
+    void lookUp(Function& function, const char* name)
+    {
+        function = reinterpret_cast<Function>(dlsym(RTLD_NEXT, name));
+    }
+
+    void resolve()
+    {
+        lookUp(realMutexLock, "pthread_mutex_lock");
+        lookUp(realCondWait, "pthread_cond_wait");
+        lookUp(realCondTimedWait, "pthread_cond_timedwait");
+        lookUp(realNanosleep, "nanosleep");
+        lookUp(realUsleep, "usleep");
+        lookUp(realRead, "read");
+        lookUp(realWrite, "write");
+    }
+
+    void report(const char* what, size_t size)
+    {
+        reporting = true;//whatever backtrace() and write() call from here is ours
+
+        auto count = ++violations;
+
+        if(count <= RealtimeAudit::maxReportedViolations){
+
+            char line[128];
+            auto length = std::snprintf(line, sizeof(line), "rt-audit: %s (%zu) on the audio thread, violation %d\n", what, size, count);
+            ::write(STDERR_FILENO, line, (size_t) juce::jlimit(0, (int) sizeof(line) - 1, length));
+
+            void* frames[32];
+            auto depth = backtrace(frames, 32);
+            backtrace_symbols_fd(frames + 2, juce::jmax(0, depth - 2), STDERR_FILENO);//skip report() and the wrapper
+        }
+
+        reporting = false;
+    }
+
+    inline void check(const char* what, size_t size = 0)
+    {
+        if(audioThreadDepth > 0 && ! reporting && armed.load(std::memory_order_relaxed))
+            report(what, size);
+    }
+}
+
+//==============================================================================
+extern "C"
+{
+    void* malloc(size_t size) noexcept                             { check("malloc", size); return __libc_malloc(size); }
+    void* calloc(size_t count, size_t size) noexcept               { check("calloc", count * size); return __libc_calloc(count, size); }
+    void* realloc(void* pointer, size_t size) noexcept             { check("realloc", size); return __libc_realloc(pointer, size); }
+    void free(void* pointer) noexcept                              { if(pointer != nullptr) check("free"); __libc_free(pointer); }
+    void* memalign(size_t alignment, size_t size) noexcept         { check("memalign", size); return __libc_memalign(alignment, size); }
+    void* aligned_alloc(size_t alignment, size_t size) noexcept    { check("aligned_alloc", size); return __libc_memalign(alignment, size); }
+
+    int posix_memalign(void** result, size_t alignment, size_t size) noexcept
+    {
+        check("posix_memalign", size);
+        *result = __libc_memalign(alignment, size);
+        return *result != nullptr || size == 0 ? 0 : ENOMEM;
+    }
+
+    int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept
+    {
+        if(realMutexLock == nullptr) resolve();
+        check("pthread_mutex_lock");
+        return realMutexLock(mutex);
+    }
+
+    int pthread_cond_wait(pthread_cond_t* condition, pthread_mutex_t* mutex)
+    {
+        if(realCondWait == nullptr) resolve();
+        check("pthread_cond_wait");
+        return realCondWait(condition, mutex);
+    }
+
+    int pthread_cond_timedwait(pthread_cond_t* condition, pthread_mutex_t* mutex, const struct timespec* time)
+    {
+        if(realCondTimedWait == nullptr) resolve();
+        check("pthread_cond_timedwait");
+        return realCondTimedWait(condition, mutex, time);
+    }
+
+    int nanosleep(const struct timespec* duration, struct timespec* remaining)
+    {
+        if(realNanosleep == nullptr) resolve();
+        check("nanosleep");
+        return realNanosleep(duration, remaining);
+    }
+
+    int usleep(useconds_t microseconds)
+    {
+        if(realUsleep == nullptr) resolve();
+        check("usleep");
+        return realUsleep(microseconds);
+    }
+
+    ssize_t read(int file, void* buffer, size_t size)
+    {
+        if(realRead == nullptr) resolve();
+        check("read", size);
+        return realRead(file, buffer, size);
+    }
+
+    ssize_t write(int file, const void* buffer, size_t size)
+    {
+        if(realWrite == nullptr) resolve();
+        check("write", size);
+        return realWrite(file, buffer, size);
+    }
+}
+
+//==============================================================================
+bool RealtimeAudit::isAvailable() noexcept   { return true; }
+
+void RealtimeAudit::arm()
+{
+    resolve();
+
+    //the first backtrace() loads libgcc, which allocates. get that over with now
+    void* frames[4];
+    backtrace(frames, 4);
+
+    violations = 0;
+    armed = true;
+}
+
+void RealtimeAudit::disarm() noexcept           { armed = false; }
+int RealtimeAudit::getNumViolations() noexcept  { return violations.load(); }
+
+RealtimeAudit::ScopedAudioThread::ScopedAudioThread() noexcept   { ++audioThreadDepth; }
+RealtimeAudit::ScopedAudioThread::~ScopedAudioThread() noexcept  { --audioThreadDepth; }
+
+#else
+
+bool RealtimeAudit::isAvailable() noexcept   { return false; }
+void RealtimeAudit::arm()                       {}
+void RealtimeAudit::disarm() noexcept           {}
+int RealtimeAudit::getNumViolations() noexcept  { return 0; }
+
+RealtimeAudit::ScopedAudioThread::ScopedAudioThread() noexcept   {}
+RealtimeAudit::ScopedAudioThread::~ScopedAudioThread() noexcept  {}
+
+#endif
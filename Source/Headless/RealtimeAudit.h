@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    RealtimeAudit.h
+    Created: 19 Oct 2026
+
+    Catches heap allocation, locking and blocking system calls made on the
+    audio thread. Debug builds of MusicPlayerHeadless only (see
+    Builds/LinuxHeadless/Makefile), driven by --rt-audit.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    The daemon executable defines malloc, calloc, realloc, free, the aligned
+    allocators, pthread_mutex_lock, the pthread_cond waits, nanosleep, usleep,
+    read and write itself, so every library it links against ends up calling
+    those first. They pass straight through to glibc unless the audit is armed
+    and the calling thread is inside a ScopedAudioThread, in which case the call
+    is counted and the first few are written to stderr with a backtrace.
+
+    Nothing here allocates or locks while reporting, since it is usually running
+    inside malloc at the time.
+*/
+class RealtimeAudit
+{
+public:
+    /** False in builds without MUSICPLAYER_RT_AUDIT: the calls below do nothing. */
+    static bool isAvailable() noexcept;
+
+    static void arm();
+    static void disarm() noexcept;
+
+    static int getNumViolations() noexcept;
+
+    /** Marks the current thread as the audio thread for as long as it exists. */
+    struct ScopedAudioThread
+    {
+        ScopedAudioThread() noexcept;
+        ~ScopedAudioThread() noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedAudioThread)
+    };
+
+    static constexpr int maxReportedViolations = 16;//with backtraces. the rest are only counted
+
+private:
+    RealtimeAudit() = delete;
+};
@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    HostTransportSync.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "HostTransportSync.h"
+#include <cmath>
+
+void HostTransportSync::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    reset();
+}
+
+void HostTransportSync::reset()
+{
+    expectedPosition = unknownPosition;
+    numSegments = 0;
+    prerollRequested = false;
+}
+
+int HostTransportSync::update(const juce::AudioPlayHead::CurrentPositionInfo& info, int numSamples)
+{
+    numSegments = 0;
+    prerollRequested = false;
+
+    const auto position = info.timeInSamples;
+
+    if(! info.isPlaying && ! info.isRecording){
+
+        //parked: keep the read-ahead primed at the host cursor so that pressing play doesn't stall
+        if(position != expectedPosition){
+            prerollRequested = true;
+            prerollPosition = juce::jmax((juce::int64) 0, position);
+            expectedPosition = position;
+        }
+
+        return 0;
+    }
+
+    auto loopStart = ppqToSamples(info.ppqLoopStart, info);
+    auto loopEnd = ppqToSamples(info.ppqLoopEnd, info);
+    bool looping = info.isLooping && info.bpm > 0.0 && loopEnd > loopStart;
+
+    int first = numSamples;
+
+    //most hosts split the block at the loop end themselves, but not all of them do
+    if(looping && position < loopEnd && position + numSamples > loopEnd)
+        first = (int) (loopEnd - position);
+
+    addSegment(0, first, position);
+
+    if(first < numSamples)
+        addSegment(first, numSamples - first, loopStart);
+
+    return numSegments;
+}
+
+void HostTransportSync::addSegment(int startSample, int numSamples, juce::int64 timelinePosition)
+{
+    if(numSamples <= 0)
+        return;
+
+    if(timelinePosition < 0){
+
+        auto numSilent = (int) juce::jmin((juce::int64) numSamples, -timelinePosition);
+
+        auto& silence = segments[(size_t) numSegments++];
+        silence.startSample = startSample;
+        silence.numSamples = numSilent;
+        silence.timelinePosition = timelinePosition;
+        silence.silent = true;
+        silence.needsRelocation = false;
+
+        expectedPosition = timelinePosition + numSilent;
+        startSample += numSilent;
+        numSamples -= numSilent;
+        timelinePosition += numSilent;
+
+        if(numSamples <= 0)
+            return;
+    }
+
+    jassert(numSegments < maxSegments);
+
+    auto& segment = segments[(size_t) numSegments++];
+    segment.startSample = startSample;
+    segment.numSamples = numSamples;
+    segment.timelinePosition = timelinePosition;
+    segment.silent = false;
+    segment.needsRelocation = (timelinePosition != expectedPosition);
+
+    expectedPosition = timelinePosition + numSamples;
+}
+
+juce::int64 HostTransportSync::ppqToSamples(double ppq, const juce::AudioPlayHead::CurrentPositionInfo& info) const
+{
+    if(info.bpm <= 0.0)
+        return 0;
+
+    //from where the host is now, at the tempo it's at now: exact for a loop in a stretch of constant
+    //tempo, whatever the tempo map did before it. from ppq 0 it would be off by every earlier change
+    return info.timeInSamples + (juce::int64) std::llround((ppq - info.ppqPosition) * 60.0 / info.bpm * sampleRate);
+}
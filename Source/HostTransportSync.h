@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    HostTransportSync.h
+    Created: 19 Oct 2026
+
+    Maps the host's AudioPlayHead onto the loaded file so the player can run
+    locked to the DAW timeline instead of its own free-running transport.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <limits>
+
+//==============================================================================
+/**
+    Works out, block by block, which part of the file should be heard when following
+    the host. Timeline position 0 is the start of the file.
+
+    A block is split into segments wherever the host's loop end falls inside it, or
+    where the timeline crosses zero (count-ins etc. are rendered as silence). Each
+    segment says whether it carries on from where the previous one stopped; only when
+    it doesn't does the caller need to relocate, so plain playback costs nothing and a
+    jump costs one read-ahead seek.
+*/
+class HostTransportSync
+{
+public:
+    struct Segment
+    {
+        int startSample = 0;
+        int numSamples = 0;
+        juce::int64 timelinePosition = 0;//in samples at the host rate
+        bool silent = false;//before the start of the file
+        bool needsRelocation = false;
+    };
+
+    void prepare (double newSampleRate);
+    void reset();//forget where we were, the next block will relocate
+
+    /** Splits the next block up according to the host position.
+        Returns the number of segments to render, 0 if the host isn't rolling. */
+    int update (const juce::AudioPlayHead::CurrentPositionInfo& info, int numSamples);
+
+    const Segment& getSegment (int index) const     { return segments[(size_t) index]; }
+
+    /** True if the host was moved while stopped. The caller should seek there straight
+        away so the read-ahead has filled up by the time the host starts rolling. */
+    bool needsPreroll() const                       { return prerollRequested; }
+    juce::int64 getPrerollPosition() const          { return prerollPosition; }
+
+private:
+    void addSegment (int startSample, int numSamples, juce::int64 timelinePosition);
+    juce::int64 ppqToSamples (double ppq, const juce::AudioPlayHead::CurrentPositionInfo& info) const;
+
+    static constexpr juce::int64 unknownPosition = std::numeric_limits<juce::int64>::min();
+    static constexpr int maxSegments = 4;
+
+    double sampleRate = 44100.0;
+    juce::int64 expectedPosition = unknownPosition;//where the last segment ended
+
+    std::array<Segment, maxSegments> segments;
+    int numSegments = 0;
+
+    bool prerollRequested = false;
+    juce::int64 prerollPosition = 0;
+};
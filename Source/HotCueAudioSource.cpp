@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+    HotCueAudioSource.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "HotCueAudioSource.h"
+
+HotCueAudioSource::HotCueAudioSource(juce::PositionableAudioSource* s) : upstream(s)
+{
+    jassert(upstream != nullptr);
+}
+
+std::unique_ptr<PreDecodedAudio> HotCueAudioSource::decodeCue(juce::AudioFormatReader& reader, juce::int64 cuePosition,
+                                                              SampleStorage::Format format)
+{
+    auto preroll = (juce::int64) (prerollSeconds * reader.sampleRate);
+    auto length = (juce::int64) (cueSeconds * reader.sampleRate);
+
+    return PreDecodedAudio::decode(reader, cuePosition - preroll, cuePosition + length, format);
+}
+
+void HotCueAudioSource::setCueAudio(int index, std::unique_ptr<PreDecodedAudio> audio)
+{
+    jassert(juce::isPositiveAndBelow(index, maxCues));
+
+    {
+        const juce::SpinLock::ScopedLockType lock(cueLock);
+        std::swap(cues[(size_t) index], audio);
+        cuesChanged = true;
+    }
+
+    //audio now holds the old cue and is freed here, off the audio thread
+}
+
+//==============================================================================
+void HotCueAudioSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    upstream->prepareToPlay(samplesPerBlockExpected, sampleRate);
+}
+
+void HotCueAudioSource::releaseResources()
+{
+    upstream->releaseResources();
+}
+
+void HotCueAudioSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& info)
+{
+    const juce::SpinLock::ScopedLockType lock(cueLock);
+
+    int startSample = info.startSample;
+    int numSamples = info.numSamples;
+
+    if(cuesChanged){
+
+        //the cue we were playing may have been freed, so carry on from the stream
+        if(serving != nullptr){
+            serving = nullptr;
+            upstream->setNextReadPosition(position);
+        }
+
+        cuesChanged = false;
+    }
+
+    if(serving != nullptr){
+
+        auto numRead = serving->read(*info.buffer, startSample, numSamples, position);
+
+        startSample += numRead;
+        numSamples -= numRead;
+        position += numRead;
+    }
+
+    if(numSamples > 0){
+
+        serving = nullptr;//the read-ahead buffer is waiting at the end of the cue
+        upstream->getNextAudioBlock(juce::AudioSourceChannelInfo(info.buffer, startSample, numSamples));
+        position = upstream->getNextReadPosition();//may have held back at the write head of a growing file
+    }
+}
+
+void HotCueAudioSource::setReverse(bool shouldReverse)
+{
+    const juce::SpinLock::ScopedLockType lock(cueLock);
+
+    //cue audio only plays forwards, so carry on from the stream
+    if(shouldReverse && serving != nullptr){
+        serving = nullptr;
+        upstream->setNextReadPosition(position);
+    }
+
+    reversed = shouldReverse;
+}
+
+void HotCueAudioSource::setNextReadPosition(juce::int64 newPosition)
+{
+    const juce::SpinLock::ScopedLockType lock(cueLock);
+
+    position = newPosition;
+    serving = nullptr;
+    cuesChanged = false;
+
+    for(auto& cue : cues){
+        if(! reversed && cue != nullptr && cue->contains(newPosition)){
+            serving = cue.get();
+            break;
+        }
+    }
+
+    upstream->setNextReadPosition(serving != nullptr ? serving->getEndPosition() : newPosition);
+}
+
+juce::int64 HotCueAudioSource::getNextReadPosition() const
+{
+    return position;
+}
+
+juce::int64 HotCueAudioSource::getTotalLength() const
+{
+    return upstream->getTotalLength();
+}
+
+bool HotCueAudioSource::isLooping() const
+{
+    return upstream->isLooping();
+}
+
+void HotCueAudioSource::setLooping(bool shouldLoop)
+{
+    upstream->setLooping(shouldLoop);
+}
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    HotCueAudioSource.h
+    Created: 19 Oct 2026
+
+    Hot cues that start playing in the block they're triggered in.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PreDecodedAudio.h"
+#include <array>
+#include <memory>
+
+//==============================================================================
+/**
+    Keeps a second or so of decoded audio from each hot cue onwards. A seek that
+    lands in one of them plays straight out of memory while the read-ahead buffer
+    below is sent on to the end of that audio, so it has caught up by the time
+    we get there.
+
+    Positions are in samples at the file's sample rate. In reverse, cue audio
+    isn't used and seeks go straight to the read-ahead buffer.
+*/
+class HotCueAudioSource  : public juce::PositionableAudioSource
+{
+public:
+    static constexpr int maxCues = 8;
+    static constexpr double cueSeconds = 1.0;
+    static constexpr double prerollSeconds = 0.01;//covers rounding when the transport seeks by time
+
+    explicit HotCueAudioSource (juce::PositionableAudioSource* upstream);//not owned
+
+    /** Background threads only. */
+    static std::unique_ptr<PreDecodedAudio> decodeCue (juce::AudioFormatReader& reader, juce::int64 cuePosition,
+                                                       SampleStorage::Format format = SampleStorage::Format::float32);
+
+    /** Replaces (or with nullptr, drops) a cue's audio. Anything replaced is deleted on the calling thread. */
+    void setCueAudio (int index, std::unique_ptr<PreDecodedAudio> audio);
+
+    /** Audio thread (or any, it takes the cue lock). */
+    void setReverse (bool shouldReverse);
+
+    //==============================================================================
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock (const juce::AudioSourceChannelInfo& info) override;
+
+    void setNextReadPosition (juce::int64 newPosition) override;
+    juce::int64 getNextReadPosition() const override;
+    juce::int64 getTotalLength() const override;
+    bool isLooping() const override;
+    void setLooping (bool shouldLoop) override;
+
+private:
+    juce::PositionableAudioSource* upstream;
+
+    //only setCueAudio takes this from outside the audio thread, and only for a pointer swap
+    juce::SpinLock cueLock;
+    std::array<std::unique_ptr<PreDecodedAudio>, maxCues> cues;
+    bool cuesChanged = false;
+
+    const PreDecodedAudio* serving = nullptr;//the cue we're playing from, upstream is parked at its end
+    juce::int64 position = 0;
+    bool reversed = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HotCueAudioSource)
+};
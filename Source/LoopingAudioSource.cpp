@@ -0,0 +1,231 @@
+/*
+  ==============================================================================
+
+    LoopingAudioSource.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "LoopingAudioSource.h"
+#include <cmath>
+
+LoopingAudioSource::LoopingAudioSource(juce::PositionableAudioSource* s, double rate,
+                                       const std::atomic<float>* enabled, const std::atomic<float>* fade)
+    : upstream(s), sourceSampleRate(rate), loopEnabled(enabled), crossfadeMs(fade)
+{
+    jassert(upstream != nullptr);
+}
+
+std::unique_ptr<LoopingAudioSource::Region> LoopingAudioSource::decodeRegion(juce::AudioFormatReader& reader,
+                                                                             juce::int64 loopIn, juce::int64 loopOut,
+                                                                             SampleStorage::Format format)
+{
+    auto region = std::make_unique<Region>();
+    region->loopIn = loopIn;
+    region->loopOut = loopOut;
+
+    auto preroll = (juce::int64) (maxCrossfadeSeconds * reader.sampleRate);
+    auto head = (juce::int64) (headSeconds * reader.sampleRate);
+
+    region->head = std::move(*PreDecodedAudio::decode(reader, loopIn - preroll, loopIn + head, format));
+
+    return region;
+}
+
+void LoopingAudioSource::setRegion(std::unique_ptr<Region> newRegion)
+{
+    {
+        const juce::SpinLock::ScopedLockType lock(regionLock);
+        std::swap(region, newRegion);
+        regionChanged = true;
+    }
+
+    //newRegion now holds the old one and goes away here, off the audio thread
+}
+
+//==============================================================================
+void LoopingAudioSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    fadeSource.setSize(2, juce::jmax(samplesPerBlockExpected, 512));
+    upstream->prepareToPlay(samplesPerBlockExpected, sampleRate);
+}
+
+void LoopingAudioSource::releaseResources()
+{
+    upstream->releaseResources();
+}
+
+void LoopingAudioSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& info)
+{
+    const juce::SpinLock::ScopedLockType lock(regionLock);
+
+    if(regionChanged){
+
+        //the head we were playing from may have gone, so pick up from the stream again
+        if(servingHead){
+            servingHead = false;
+            upstream->setNextReadPosition(position);
+        }
+
+        regionChanged = false;
+    }
+
+    //the loop only engages while we're before loop-out, so a jump past it plays on
+    const Region* loop = nullptr;
+
+    if(region != nullptr && ! reversed && loopEnabled->load() > 0.5f && position < region->loopOut)
+        loop = region.get();
+
+    int done = 0;
+
+    while(done < info.numSamples){
+
+        int numThisTime = info.numSamples - done;
+
+        if(loop != nullptr)
+            numThisTime = (int) juce::jmin((juce::int64) numThisTime, loop->loopOut - position);
+
+        read(*info.buffer, info.startSample + done, numThisTime, position);
+
+        if(loop != nullptr)
+            applySeamCrossfade(*loop, *info.buffer, info.startSample + done, numThisTime);
+
+        //upstream may have held back at the write head of a growing file
+        position = servingHead ? position + numThisTime : upstream->getNextReadPosition();
+        done += numThisTime;
+
+        if(loop != nullptr && position >= loop->loopOut)
+            wrap(*loop);
+    }
+}
+
+void LoopingAudioSource::read(juce::AudioBuffer<float>& buffer, int startSample, int numSamples, juce::int64 readPosition)
+{
+    if(servingHead && region != nullptr){
+
+        auto numRead = region->head.read(buffer, startSample, numSamples, readPosition);
+
+        startSample += numRead;
+        numSamples -= numRead;
+    }
+
+    if(numSamples > 0){
+
+        //past the end of the head, upstream has been waiting for us right there
+        servingHead = false;
+        upstream->getNextAudioBlock(juce::AudioSourceChannelInfo(&buffer, startSample, numSamples));
+    }
+}
+
+int LoopingAudioSource::getCrossfadeLength(const Region& loop) const
+{
+    auto requested = (juce::int64) (crossfadeMs->load() * 0.001 * sourceSampleRate);
+    auto available = juce::jmin(loop.loopIn, loop.head.getEndPosition()) - loop.head.startPosition;//decoded audio from before loop-in
+    auto longest = (loop.loopOut - loop.loopIn) / 2;
+
+    return (int) juce::jmax((juce::int64) 0, juce::jmin(requested, available, longest));
+}
+
+void LoopingAudioSource::applySeamCrossfade(const Region& loop, juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    //over the last fadeLength samples before loop-out, fade out the stream and fade in
+    //what comes just before loop-in, so by loop-out we're already playing the loop start
+    auto fadeLength = getCrossfadeLength(loop);
+
+    if(fadeLength == 0)
+        return;
+
+    auto fadeStart = loop.loopOut - fadeLength;
+    auto first = juce::jmax(position, fadeStart);
+    auto last = juce::jmin(position + numSamples, loop.loopOut);
+
+    auto numChannels = juce::jmin(buffer.getNumChannels(), fadeSource.getNumChannels());
+
+    //the head may be stored compactly, so it's expanded a chunk at a time first
+    for(auto chunkStart = first; chunkStart < last && fadeSource.getNumSamples() > 0; chunkStart += fadeSource.getNumSamples()){
+
+        auto chunkLength = (int) juce::jmin(last - chunkStart, (juce::int64) fadeSource.getNumSamples());
+        loop.head.read(fadeSource, 0, chunkLength, loop.loopIn - fadeLength + (chunkStart - fadeStart));
+
+        for(int i = 0; i < chunkLength; ++i){
+
+            auto k = chunkStart + i - fadeStart;
+            auto angle = juce::MathConstants<float>::halfPi * ((float) k + 0.5f) / (float) fadeLength;
+            auto fadeOut = std::cos(angle);
+            auto fadeIn = std::sin(angle);
+
+            auto destIndex = startSample + (int) (chunkStart + i - position);
+
+            for(int channel = 0; channel < numChannels; ++channel){
+                auto* dest = buffer.getWritePointer(channel);
+                dest[destIndex] = dest[destIndex] * fadeOut + fadeSource.getSample(channel, i) * fadeIn;
+            }
+        }
+    }
+}
+
+void LoopingAudioSource::wrap(const Region& loop)
+{
+    position = loop.loopIn;
+
+    if(loop.head.contains(loop.loopIn)){
+        servingHead = true;
+        upstream->setNextReadPosition(loop.head.getEndPosition());//gives the read-ahead the whole head to refill
+    }
+    else{
+        servingHead = false;
+        upstream->setNextReadPosition(loop.loopIn);
+    }
+}
+
+//==============================================================================
+void LoopingAudioSource::setReverse(bool shouldReverse)
+{
+    const juce::SpinLock::ScopedLockType lock(regionLock);
+
+    //the head only plays forwards, so hand back to the stream right where we are
+    if(shouldReverse && servingHead){
+        servingHead = false;
+        upstream->setNextReadPosition(position);
+    }
+
+    reversed = shouldReverse;
+}
+
+void LoopingAudioSource::setNextReadPosition(juce::int64 newPosition)
+{
+    const juce::SpinLock::ScopedLockType lock(regionLock);
+
+    position = newPosition;
+
+    //a seek into the decoded head is instant too
+    if(region != nullptr && ! reversed && region->head.contains(newPosition)){
+        servingHead = true;
+        upstream->setNextReadPosition(region->head.getEndPosition());
+    }
+    else{
+        servingHead = false;
+        upstream->setNextReadPosition(newPosition);
+    }
+}
+
+juce::int64 LoopingAudioSource::getNextReadPosition() const
+{
+    return position;
+}
+
+juce::int64 LoopingAudioSource::getTotalLength() const
+{
+    return upstream->getTotalLength();
+}
+
+bool LoopingAudioSource::isLooping() const
+{
+    return upstream->isLooping();
+}
+
+void LoopingAudioSource::setLooping(bool shouldLoop)
+{
+    upstream->setLooping(shouldLoop);
+}
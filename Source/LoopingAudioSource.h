@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    LoopingAudioSource.h
+    Created: 19 Oct 2026
+
+    A-B looping that wraps sample-accurately on the audio thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PreDecodedAudio.h"
+#include <atomic>
+#include <memory>
+
+//==============================================================================
+/**
+    Sits between the read-ahead buffer and the transport, and jumps from loop-out
+    back to loop-in in the middle of a block.
+
+    The start of the loop (plus a little before it, for the crossfade) is decoded
+    up front into a Region. After a wrap the first part of the loop is played from
+    that memory while the read-ahead buffer is sent on to the end of it, so the
+    wrap itself never waits on the decoder or the disk.
+
+    All positions are in samples at the file's sample rate.
+
+    Played in reverse the loop is left alone: nothing wraps and nothing comes
+    from the head, the read-ahead below does it all.
+*/
+class LoopingAudioSource  : public juce::PositionableAudioSource
+{
+public:
+    struct Region
+    {
+        juce::int64 loopIn = 0;
+        juce::int64 loopOut = 0;
+        PreDecodedAudio head;//from a little before loopIn
+    };
+
+    /** The upstream source isn't owned. The parameters are the LOOP and LOOPXF values
+        from the apvts, read on the audio thread. */
+    LoopingAudioSource (juce::PositionableAudioSource* upstream, double sourceSampleRate,
+                        const std::atomic<float>* loopEnabled, const std::atomic<float>* crossfadeMs);
+
+    /** Decodes the region a loop needs. Call from a background thread, never the audio thread. */
+    static std::unique_ptr<Region> decodeRegion (juce::AudioFormatReader& reader, juce::int64 loopIn, juce::int64 loopOut,
+                                                 SampleStorage::Format format = SampleStorage::Format::float32);
+
+    /** Swaps in a new loop (or removes it with nullptr). The old region is deleted on the calling thread. */
+    void setRegion (std::unique_ptr<Region> newRegion);
+
+    /** Audio thread (or any, it takes the region lock). The read-ahead below turns round separately. */
+    void setReverse (bool shouldReverse);
+
+    //==============================================================================
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock (const juce::AudioSourceChannelInfo& info) override;
+
+    void setNextReadPosition (juce::int64 newPosition) override;
+    juce::int64 getNextReadPosition() const override;
+    juce::int64 getTotalLength() const override;
+    bool isLooping() const override;
+    void setLooping (bool shouldLoop) override;
+
+    static constexpr double maxCrossfadeSeconds = 0.2;
+    static constexpr double headSeconds = 1.0;//how long the read-ahead has to catch up after a wrap
+
+private:
+    void read (juce::AudioBuffer<float>& buffer, int startSample, int numSamples, juce::int64 readPosition);
+    void applySeamCrossfade (const Region& loop, juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+    int getCrossfadeLength (const Region& loop) const;
+    void wrap (const Region& loop);
+
+    juce::PositionableAudioSource* upstream;
+    double sourceSampleRate;
+    const std::atomic<float>* loopEnabled;
+    const std::atomic<float>* crossfadeMs;
+
+    //region is only swapped by setRegion, which holds the lock for no more than a pointer swap
+    juce::SpinLock regionLock;
+    std::unique_ptr<Region> region;
+    bool regionChanged = false;
+
+    juce::AudioBuffer<float> fadeSource;//what comes before loop-in, expanded from the head during a fade
+
+    juce::int64 position = 0;
+    bool servingHead = false;//reading from region->audio, upstream is parked at its end
+    bool reversed = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoopingAudioSource)
+};
@@ -0,0 +1,246 @@
+/*
+  ==============================================================================
+
+    ParallelDecoder.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ParallelDecoder.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    constexpr int readBlockSize = 65536;//between polls of shouldExit
+    constexpr double matchTolerance = 1.0e-3;//residual energy against signal energy that still counts as the same audio
+    constexpr double silenceEnergy = 1.0e-8;//per sample: nothing to line up against
+
+    //reads numSamples from position into two channels, from a reader with one or two
+    //(or more, only the first two are used). positions before zero are silence
+    bool readSection(juce::AudioFormatReader& reader, float* const* channels, juce::int64 position, int numSamples)
+    {
+        if(position < 0){
+            auto numSilent = (int) juce::jmin((juce::int64) numSamples, -position);
+
+            for(int channel = 0; channel < 2; ++channel)
+                juce::FloatVectorOperations::clear(channels[channel], numSilent);
+
+            float* rest[2] = { channels[0] + numSilent, channels[1] + numSilent };
+            return readSection(reader, rest, 0, numSamples - numSilent);
+        }
+
+        if(numSamples <= 0)
+            return true;
+
+        if(! reader.read(channels, 2, position, numSamples))
+            return false;
+
+        if(reader.numChannels == 1)
+            juce::FloatVectorOperations::copy(channels[1], channels[0], numSamples);
+
+        return true;
+    }
+}
+
+//==============================================================================
+struct ParallelDecoder::Chunk
+{
+    juce::int64 start = 0, end = 0;
+    juce::AudioBuffer<float> edge{2, overlapSamples};//from start - overlapSamples
+    juce::AudioBuffer<float> tail{2, maxDriftSamples};//from end
+    bool ok = false;
+};
+
+ParallelDecoder::Result ParallelDecoder::decode(juce::AudioFormatManager& formatManager, const juce::File& file,
+                                                juce::AudioBuffer<float>& dest, int numThreads,
+                                                const std::function<bool()>& shouldExit)
+{
+    Result result;
+    auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    juce::int64 length;
+
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+
+        if(reader == nullptr || reader->lengthInSamples <= 0 || reader->lengthInSamples > std::numeric_limits<int>::max())
+            return result;
+
+        length = reader->lengthInSamples;
+    }
+
+    result.numThreads = numThreads > 0 ? numThreads : juce::SystemStats::getNumCpus();
+
+    //chunks much shorter than the run-in would spend most of their time on it
+    auto numChunks = (int) juce::jlimit((juce::int64) 1, (juce::int64) (result.numThreads * chunksPerThread), length / (overlapSamples * 8));
+    result.numThreads = juce::jmin(result.numThreads, numChunks);
+    result.numChunks = numChunks;
+
+    dest.setSize(2, (int) length, false, false, true);
+    auto* const* destChannels = dest.getArrayOfWritePointers();//taken here, so the threads never touch dest itself
+
+    std::vector<std::unique_ptr<Chunk>> chunks;
+
+    for(int i = 0; i < numChunks; ++i){
+        chunks.emplace_back(new Chunk());
+        chunks.back()->start = length * i / numChunks;
+        chunks.back()->end = length * (i + 1) / numChunks;
+    }
+
+    std::atomic<int> nextChunk{0};
+    std::atomic<int> numRunning{result.numThreads};
+    juce::WaitableEvent allDone;
+
+    {
+        juce::ThreadPool pool(result.numThreads);
+
+        for(int i = 0; i < result.numThreads; ++i){
+
+            pool.addJob([&]{
+
+                //a reader per thread, never shared
+                std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+
+                while(reader != nullptr){
+
+                    auto index = nextChunk.fetch_add(1);
+
+                    if(index >= numChunks)
+                        break;
+
+                    chunks[(size_t) index]->ok = decodeChunk(*reader, destChannels, *chunks[(size_t) index], shouldExit);
+                }
+
+                if(--numRunning == 0)
+                    allDone.signal();
+            });
+        }
+
+        allDone.wait();
+    }
+
+    for(auto& chunk : chunks)
+        if(! chunk->ok)
+            return result;
+
+    //in order, so the chunk before each edge is already right
+    for(size_t i = 1; i < chunks.size(); ++i){
+
+        bool moved = false;
+
+        if(! reconcileEdge(dest, *chunks[i], moved))
+            ++result.unmatchedEdges;
+        else if(moved)
+            ++result.realignedEdges;
+    }
+
+    result.ok = true;
+    result.seconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    return result;
+}
+
+bool ParallelDecoder::decodeChunk(juce::AudioFormatReader& reader, float* const* destChannels, Chunk& chunk,
+                                  const std::function<bool()>& shouldExit)
+{
+    //the run-in, then the chunk itself straight into its place in dest, then a little past it
+    if(chunk.start > 0 && ! readSection(reader, chunk.edge.getArrayOfWritePointers(), chunk.start - overlapSamples, overlapSamples))
+        return false;
+
+    for(auto position = chunk.start; position < chunk.end; position += readBlockSize){
+
+        if(shouldExit && shouldExit())
+            return false;
+
+        auto numSamples = (int) juce::jmin((juce::int64) readBlockSize, chunk.end - position);
+        float* channels[2] = { destChannels[0] + position, destChannels[1] + position };
+
+        if(! readSection(reader, channels, position, numSamples))
+            return false;
+    }
+
+    //reading past the end of the file gives silence, which is what belongs there
+    return readSection(reader, chunk.tail.getArrayOfWritePointers(), chunk.end, maxDriftSamples);
+}
+
+bool ParallelDecoder::reconcileEdge(juce::AudioBuffer<float>& dest, const Chunk& chunk, bool& moved)
+{
+    //the new reader's output y[n] is really x[n + drift]. compare the end of its run-in with
+    //the previous chunk, short of maxDriftSamples so every drift tried stays inside that chunk
+    auto compareStart = chunk.start - maxDriftSamples - compareSamples;
+    auto edgeOffset = (int) (compareStart - (chunk.start - overlapSamples));
+
+    if(compareStart - maxDriftSamples < 0)
+        return false;//the previous chunk is too short to check against
+
+    auto getResidual = [&](int drift, double& signal){
+
+        double residual = 0.0;
+        signal = 0.0;
+
+        for(int channel = 0; channel < 2; ++channel){
+
+            auto* y = chunk.edge.getReadPointer(channel, edgeOffset);
+            auto* x = dest.getReadPointer(channel) + compareStart + drift;
+
+            for(int i = 0; i < compareSamples; ++i){
+                auto difference = (double) y[i] - (double) x[i];
+                residual += difference * difference;
+                signal += (double) x[i] * x[i];
+            }
+        }
+
+        return residual;
+    };
+
+    double signal;
+    auto residual = getResidual(0, signal);
+
+    if(signal < silenceEnergy * compareSamples)
+        return false;//silence lines up with anything
+
+    if(residual <= signal * matchTolerance)
+        return true;//clean: the reader landed where it was told to
+
+    int bestDrift = 0;
+    auto bestResidual = residual;
+
+    for(int drift = -maxDriftSamples; drift <= maxDriftSamples; ++drift){
+
+        double driftSignal;
+        auto driftResidual = getResidual(drift, driftSignal);
+
+        if(driftResidual < bestResidual){
+            bestResidual = driftResidual;
+            bestDrift = drift;
+        }
+    }
+
+    if(bestDrift == 0 || bestResidual > signal * matchTolerance)
+        return false;
+
+    //x[m] = y[m - drift]: slide the chunk over by drift, filling the end it leaves from the edge or tail
+    auto chunkLength = (int) (chunk.end - chunk.start);
+    auto shift = std::abs(bestDrift);
+
+    for(int channel = 0; channel < 2; ++channel){
+
+        auto* samples = dest.getWritePointer(channel) + chunk.start;
+
+        if(bestDrift > 0){
+            std::memmove(samples + shift, samples, sizeof(float) * (size_t) (chunkLength - shift));
+            juce::FloatVectorOperations::copy(samples, chunk.edge.getReadPointer(channel, overlapSamples - shift), shift);
+        }
+        else{
+            std::memmove(samples, samples + shift, sizeof(float) * (size_t) (chunkLength - shift));
+            juce::FloatVectorOperations::copy(samples + chunkLength - shift, chunk.tail.getReadPointer(channel), shift);
+        }
+    }
+
+    moved = true;
+    return true;
+}
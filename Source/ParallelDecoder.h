@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    ParallelDecoder.h
+    Created: 19 Oct 2026
+
+    Decodes a whole file on every core at once, for caching, analysis and
+    offline export of long compressed files.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+
+//==============================================================================
+/**
+    The file is cut into chunks, a few per thread so the threads finish together,
+    and each thread decodes the chunks it takes with a reader of its own straight
+    into its part of the output. Nothing is shared between the threads except
+    which chunk is next.
+
+    A decoder started in the middle of a compressed stream needs a run-in before
+    its output is right (MP3's bit reservoir and overlapped synthesis, Vorbis's
+    overlapping blocks), and not every format seeks exactly to the sample. So
+    each chunk also decodes overlapSamples before its start into an edge buffer,
+    and maxDriftSamples after its end into a tail buffer. Once every chunk is in,
+    the edges are reconciled in order: the last compareSamples of the run-in are
+    matched against the end of the chunk before, which is already right. If they
+    agree at the nominal position, the edge is clean. If they agree at some other
+    offset, the chunk is moved by that much and the gap is filled from its edge or
+    tail. That way the output matches a single sequential decode across every
+    chunk edge.
+*/
+class ParallelDecoder
+{
+public:
+    static constexpr int overlapSamples = 16384;
+    static constexpr int maxDriftSamples = 2304;//two MP3 frames either way
+    static constexpr int compareSamples = 2048;
+    static constexpr int chunksPerThread = 4;
+
+    struct Result
+    {
+        bool ok = false;
+        int numThreads = 0;
+        int numChunks = 0;
+        int realignedEdges = 0;//chunks whose reader came out a few samples off, and were moved
+        int unmatchedEdges = 0;//couldn't be checked (silence), or matched nowhere; left as decoded
+        double seconds = 0.0;
+    };
+
+    /** Decodes all of file into dest, which is resized to two channels (mono is
+        copied to both, like AudioFormatReaderSource) by its length. numThreads 0
+        uses every core. shouldExit is polled by every thread between reads and
+        may be empty. Blocks until done, so not for the message or audio thread. */
+    static Result decode (juce::AudioFormatManager& formatManager, const juce::File& file,
+                          juce::AudioBuffer<float>& dest, int numThreads = 0,
+                          const std::function<bool()>& shouldExit = {});
+
+private:
+    struct Chunk;
+
+    static bool decodeChunk (juce::AudioFormatReader& reader, float* const* destChannels, Chunk& chunk,
+                             const std::function<bool()>& shouldExit);
+    static bool reconcileEdge (juce::AudioBuffer<float>& dest, const Chunk& chunk, bool& moved);
+};
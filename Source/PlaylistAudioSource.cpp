@@ -0,0 +1,269 @@
+/*
+  ==============================================================================
+
+    PlaylistAudioSource.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "PlaylistAudioSource.h"
+#include <cmath>
+
+PlaylistAudioSource::PlaylistAudioSource(const std::atomic<float>* fade) : crossfadeSeconds(fade)
+{
+    startTimerHz(50);
+}
+
+void PlaylistAudioSource::timerCallback()
+{
+    if(handOffPending.exchange(false))
+        sendChangeMessage();//the processor lets go of the old track and queues up another
+}
+
+void PlaylistAudioSource::setCurrentTrack(TrackChain* track)
+{
+    const juce::SpinLock::ScopedLockType lock(trackLock);
+    current = track;
+    next = nullptr;
+    resetMixPoints();
+}
+
+bool PlaylistAudioSource::setNextTrack(TrackChain* track)
+{
+    const juce::SpinLock::ScopedLockType lock(trackLock);
+
+    if(track != nullptr && (current == nullptr || track->sampleRate != current->sampleRate)){
+        next = nullptr;
+        resetMixPoints();
+        return false;
+    }
+
+    next = track;
+    resetMixPoints();
+    return true;
+}
+
+void PlaylistAudioSource::setMixPoints(const TrackChain* forCurrent, const TrackChain* forNext,
+                                       juce::int64 outPosition, juce::int64 inPosition, int fadeLength)
+{
+    const juce::SpinLock::ScopedLockType lock(trackLock);
+
+    if(current == nullptr || current != forCurrent || next != forNext)
+        return;
+
+    //too late once the next track is audible
+    juce::int64 end;
+    int currentFade;
+    getHandOff(end, currentFade);
+
+    if(current->getOutput()->getNextReadPosition() >= end - currentFade)
+        return;
+
+    mixOutPosition = outPosition;
+    mixInPosition = outPosition >= 0 ? juce::jmax((juce::int64) 0, inPosition) : 0;
+    mixFadeLength = outPosition >= 0 ? fadeLength : -1;
+
+    next->getOutput()->setNextReadPosition(mixInPosition);
+}
+
+void PlaylistAudioSource::resetMixPoints()
+{
+    mixOutPosition = -1;
+    mixInPosition = 0;
+    mixFadeLength = -1;
+}
+
+void PlaylistAudioSource::getHandOff(juce::int64& end, int& fadeLength) const
+{
+    auto* source = current->getOutput();
+    end = source->getTotalLength();
+
+    if(mixOutPosition >= 0)
+        end = juce::jmin(end, mixOutPosition);
+
+    fadeLength = 0;
+
+    if(next != nullptr && crossfadeBuffer.getNumSamples() > 0){
+
+        auto requested = mixFadeLength >= 0 ? (juce::int64) mixFadeLength
+                                            : (juce::int64) (crossfadeSeconds->load() * current->sampleRate);
+        fadeLength = (int) juce::jlimit((juce::int64) 0, end, requested);
+    }
+}
+
+TrackChain* PlaylistAudioSource::getCurrentTrack() const
+{
+    const juce::SpinLock::ScopedLockType lock(trackLock);
+    return current;
+}
+
+TrackChain* PlaylistAudioSource::getNextTrack() const
+{
+    const juce::SpinLock::ScopedLockType lock(trackLock);
+    return next;
+}
+
+void PlaylistAudioSource::prepareTrack(TrackChain& track) const
+{
+    auto blockSize = preparedBlockSize.load();
+
+    if(blockSize > 0)
+        track.getOutput()->prepareToPlay(blockSize, preparedSampleRate.load());
+}
+
+//==============================================================================
+void PlaylistAudioSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    crossfadeBuffer.setSize(2, juce::jmax(samplesPerBlockExpected, 4096));
+    preparedBlockSize.store(samplesPerBlockExpected);
+    preparedSampleRate.store(sampleRate);
+
+    const juce::SpinLock::ScopedLockType lock(trackLock);
+
+    if(current != nullptr)
+        current->getOutput()->prepareToPlay(samplesPerBlockExpected, sampleRate);
+
+    if(next != nullptr)
+        next->getOutput()->prepareToPlay(samplesPerBlockExpected, sampleRate);
+}
+
+void PlaylistAudioSource::releaseResources()
+{
+    const juce::SpinLock::ScopedLockType lock(trackLock);
+
+    if(current != nullptr)
+        current->getOutput()->releaseResources();
+
+    if(next != nullptr)
+        next->getOutput()->releaseResources();
+}
+
+void PlaylistAudioSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& info)
+{
+    const juce::SpinLock::ScopedLockType lock(trackLock);
+
+    if(current == nullptr){
+        info.clearActiveBufferRegion();
+        return;
+    }
+
+    bool backwards = reversed.load();
+
+    if(current->isReversed() != backwards)
+        current->setReverse(backwards);
+
+    bool handedOff = false;
+    int done = 0;
+
+    while(done < info.numSamples){
+
+        auto* source = current->getOutput();
+        auto position = source->getNextReadPosition();
+        bool canHandOff = next != nullptr && ! source->isLooping() && ! backwards;
+
+        juce::int64 end;
+        int fadeLength;
+        getHandOff(end, fadeLength);
+
+        auto fadeStart = end - fadeLength;
+        juce::AudioSourceChannelInfo remaining(info.buffer, info.startSample + done, info.numSamples - done);
+
+        if(! canHandOff || position < fadeStart){
+
+            //plain playback, up to the start of the fade (or the end) at most
+            if(canHandOff)
+                remaining.numSamples = (int) juce::jmin((juce::int64) remaining.numSamples, fadeStart - position);
+
+            source->getNextAudioBlock(remaining);
+            done += remaining.numSamples;
+        }
+        else if(position < end){
+
+            done += renderCrossfade(remaining, fadeStart, end, fadeLength);
+        }
+        else{
+
+            //the current track has run out (or reached its mix point): carry on from the next one at this very sample
+            current = next;
+            next = nullptr;
+            resetMixPoints();
+            handedOff = true;
+        }
+    }
+
+    if(handedOff)
+        handOffPending = true;//sendChangeMessage() locks, see timerCallback
+}
+
+int PlaylistAudioSource::renderCrossfade(const juce::AudioSourceChannelInfo& info, juce::int64 fadeStart, juce::int64 end, int fadeLength)
+{
+    auto* outgoing = current->getOutput();
+    auto* incoming = next->getOutput();
+
+    auto position = outgoing->getNextReadPosition();
+    auto numSamples = (int) juce::jmin((juce::int64) info.numSamples, end - position,
+                                       (juce::int64) crossfadeBuffer.getNumSamples());
+
+    juce::AudioSourceChannelInfo outgoingInfo(info.buffer, info.startSample, numSamples);
+    juce::AudioSourceChannelInfo incomingInfo(&crossfadeBuffer, 0, numSamples);
+
+    outgoing->getNextAudioBlock(outgoingInfo);
+    incoming->getNextAudioBlock(incomingInfo);
+
+    auto numChannels = juce::jmin(info.buffer->getNumChannels(), crossfadeBuffer.getNumChannels());
+
+    for(int i = 0; i < numSamples; ++i){
+
+        auto k = position + i - fadeStart;
+        auto angle = juce::MathConstants<float>::halfPi * ((float) k + 0.5f) / (float) fadeLength;
+        auto fadeOut = std::cos(angle);
+        auto fadeIn = std::sin(angle);
+
+        for(int channel = 0; channel < numChannels; ++channel){
+            auto* dest = info.buffer->getWritePointer(channel, info.startSample);
+            dest[i] = dest[i] * fadeOut + crossfadeBuffer.getSample(channel, i) * fadeIn;
+        }
+    }
+
+    return numSamples;
+}
+
+//==============================================================================
+void PlaylistAudioSource::setNextReadPosition(juce::int64 newPosition)
+{
+    const juce::SpinLock::ScopedLockType lock(trackLock);
+
+    if(current != nullptr)
+        current->getOutput()->setNextReadPosition(newPosition);
+
+    //seeking back out of a fade leaves the next track part way in, so start it again
+    if(next != nullptr)
+        next->getOutput()->setNextReadPosition(mixInPosition);
+}
+
+juce::int64 PlaylistAudioSource::getNextReadPosition() const
+{
+    const juce::SpinLock::ScopedLockType lock(trackLock);
+    return current != nullptr ? current->getOutput()->getNextReadPosition() : 0;
+}
+
+juce::int64 PlaylistAudioSource::getTotalLength() const
+{
+    const juce::SpinLock::ScopedLockType lock(trackLock);
+    return current != nullptr ? current->getOutput()->getTotalLength() : 0;
+}
+
+bool PlaylistAudioSource::isLooping() const
+{
+    const juce::SpinLock::ScopedLockType lock(trackLock);
+    return current != nullptr && current->getOutput()->isLooping();
+}
+
+void PlaylistAudioSource::setLooping(bool shouldLoop)
+{
+    const juce::SpinLock::ScopedLockType lock(trackLock);
+
+    if(current != nullptr)
+        current->getOutput()->setLooping(shouldLoop);
+}
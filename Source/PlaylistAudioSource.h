@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    PlaylistAudioSource.h
+    Created: 19 Oct 2026
+
+    Gapless (or crossfaded) hand-off from one track to the next.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "TrackChain.h"
+#include <atomic>
+
+//==============================================================================
+/**
+    What the transport plays. Passes everything through to the current track
+    and, once it runs out, carries on from the next one at the exact sample,
+    inside the same block. With a crossfade set, the next track fades in with
+    an equal-power curve over the end of the current one.
+
+    The tracks aren't owned: the processor keeps them alive and only lets go of
+    the old one after the change message for the hand-off, by which time the
+    audio thread has stopped using it. The audio thread only raises a flag for
+    that message, a timer sends it.
+
+    The transport resamples at a single rate, so only a next track at the same
+    sample rate as the current one is taken. Otherwise the current track just
+    ends and the processor loads the next the ordinary way.
+
+    Mix points move the hand-off from the end of the current track to a chosen
+    position, start the next track part way in and can set the crossfade length,
+    which is how beat-matched transitions line up downbeats.
+
+    In reverse the current track plays backwards towards its start and there's
+    no hand-off; the next track waits until we're going forwards again.
+*/
+class PlaylistAudioSource  : public juce::PositionableAudioSource,
+                             public juce::ChangeBroadcaster,
+                             private juce::Timer
+{
+public:
+    explicit PlaylistAudioSource (const std::atomic<float>* crossfadeSeconds);
+
+    /** Message thread. Also forgets any next track. */
+    void setCurrentTrack (TrackChain* track);
+
+    /** Returns false (and won't play it) if it can't follow the current track gaplessly. */
+    bool setNextTrack (TrackChain* track);
+
+    TrackChain* getCurrentTrack() const;
+    TrackChain* getNextTrack() const;
+
+    /** Any thread. The current track is turned round at the start of the next block. */
+    void setReverse (bool shouldReverse)        { reversed = shouldReverse; }
+
+    /** Hands off at outPosition in the current track instead of its end, with the next
+        one starting from inPosition. A fadeLength of 0 or more (samples) replaces the
+        crossfade setting. Ignored unless the pair is still current and next, or if the
+        fade has already started. outPosition -1 goes back to the end and the setting. */
+    void setMixPoints (const TrackChain* forCurrent, const TrackChain* forNext,
+                       juce::int64 outPosition, juce::int64 inPosition, int fadeLength);
+
+    /** Prepares a track with the block size and rate we were last prepared with,
+        which also fills its read-ahead. Fine to call from a background thread. */
+    void prepareTrack (TrackChain& track) const;
+
+    //==============================================================================
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock (const juce::AudioSourceChannelInfo& info) override;
+
+    void setNextReadPosition (juce::int64 newPosition) override;
+    juce::int64 getNextReadPosition() const override;
+    juce::int64 getTotalLength() const override;
+    bool isLooping() const override;
+    void setLooping (bool shouldLoop) override;
+
+    static constexpr float maxCrossfadeSeconds = 10.0f;
+
+private:
+    void timerCallback() override;
+    void getHandOff (juce::int64& end, int& fadeLength) const;
+    void resetMixPoints();
+    int renderCrossfade (const juce::AudioSourceChannelInfo& info, juce::int64 fadeStart, juce::int64 end, int fadeLength);
+
+    const std::atomic<float>* crossfadeSeconds;
+
+    mutable juce::SpinLock trackLock;//the audio thread swaps current for next under this
+    TrackChain* current = nullptr;
+    TrackChain* next = nullptr;
+    juce::int64 mixOutPosition = -1;//-1 is the end of the current track
+    juce::int64 mixInPosition = 0;
+    int mixFadeLength = -1;//-1 follows crossfadeSeconds
+    std::atomic<bool> reversed{false};
+    std::atomic<bool> handOffPending{false};//set by the audio thread, the timer sends the change message
+
+    juce::AudioBuffer<float> crossfadeBuffer;//the incoming track during a fade
+    std::atomic<int> preparedBlockSize{0};
+    std::atomic<double> preparedSampleRate{0.0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PlaylistAudioSource)
+};
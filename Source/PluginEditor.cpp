@@ -12,11 +12,11 @@
 
 //==============================================================================
 MusicPlayerAudioProcessorEditor::MusicPlayerAudioProcessorEditor (MusicPlayerAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p)
+    : AudioProcessorEditor (&p), analyserDisplay (p.analyser, p.limiter), audioProcessor (p)
 {
     // Make sure that before the constructor has finished, you've set the
     // editor's size to whatever you need it to be.
-    setSize (400, 300);
+    setSize (400, 490);
 
 
 
@@ -24,6 +24,14 @@ MusicPlayerAudioProcessorEditor::MusicPlayerAudioProcessorEditor (MusicPlayerAud
     addAndMakeVisible(&openButton);
     openButton.addListener(this);
 
+    addAndMakeVisible(&queueButton);
+    queueButton.addListener(this);
+
+    analyseButton.setButtonText("Analyse Folder");
+    addAndMakeVisible(&analyseButton);
+    analyseButton.addListener(this);
+    updateQueueButton();
+
     playButton.setButtonText("Play");
     addAndMakeVisible(&playButton);
     playButton.addListener(this);
@@ -62,11 +70,11 @@ MusicPlayerAudioProcessorEditor::MusicPlayerAudioProcessorEditor (MusicPlayerAud
     positionSlider.setColour(juce::Slider::thumbColourId, juce::Colours::darkgoldenrod);
 
     if(audioProcessor.fileLoaded){
-        positionSlider.setRange(0.0,audioProcessor.transport.getLengthInSeconds(),1.0);//default. will be set properly when file loaded
+        positionSlider.setRange(0.0,audioProcessor.transport.getLengthInSeconds(),scrubInterval);//default. will be set properly when file loaded
         positionSlider.setValue(audioProcessor.transport.getCurrentPosition(), juce::dontSendNotification);
     }
     else{
-        positionSlider.setRange(0.0,10.0,1.0);
+        positionSlider.setRange(0.0,10.0,scrubInterval);
         positionSlider.setValue(0.0, juce::dontSendNotification);
     }
 
@@ -80,6 +88,50 @@ MusicPlayerAudioProcessorEditor::MusicPlayerAudioProcessorEditor (MusicPlayerAud
     volSliderAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.apvts
             ,"VOL",volumeSlider);
 
+    syncButton.setButtonText("Sync to host");
+    addAndMakeVisible(&syncButton);
+    syncButton.setColour(juce::ToggleButton::textColourId, juce::Colours::goldenrod);
+    syncButtonAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(audioProcessor.apvts
+            ,"SYNC",syncButton);
+
+    loopInButton.setButtonText("Loop In");
+    addAndMakeVisible(&loopInButton);
+    loopInButton.addListener(this);
+    loopInButton.setLookAndFeel(&lookV3);
+
+    loopOutButton.setButtonText("Loop Out");
+    addAndMakeVisible(&loopOutButton);
+    loopOutButton.addListener(this);
+    loopOutButton.setLookAndFeel(&lookV3);
+
+    loopButton.setButtonText("Loop");
+    addAndMakeVisible(&loopButton);
+    loopButton.setColour(juce::ToggleButton::textColourId, juce::Colours::goldenrod);
+    loopButtonAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(audioProcessor.apvts
+            ,"LOOP",loopButton);
+
+    followButton.setButtonText("Follow files still being written");
+    addAndMakeVisible(&followButton);
+    followButton.setColour(juce::ToggleButton::textColourId, juce::Colours::goldenrod);
+    followButtonAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(audioProcessor.apvts
+            ,"GROW",followButton);
+
+    automixButton.setButtonText("Automix");
+    addAndMakeVisible(&automixButton);
+    automixButton.setColour(juce::ToggleButton::textColourId, juce::Colours::goldenrod);
+    automixButtonAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(audioProcessor.apvts
+            ,"AUTOMIX",automixButton);
+
+    for(int i = 0; i < (int) cueButtons.size(); ++i){
+        cueButtons[(size_t) i].setButtonText(juce::String(i + 1));
+        addAndMakeVisible(&cueButtons[(size_t) i]);
+        cueButtons[(size_t) i].addListener(this);
+        cueButtons[(size_t) i].setLookAndFeel(&lookV3);
+        updateCueButton(i);
+    }
+
+    addAndMakeVisible(&analyserDisplay);
+
     if(audioProcessor.transport.isPlaying())//will be triggered if plugin window is closed and opened again(new gui instance)
         startTimer(1000);//ms intervals
 }
@@ -99,7 +151,7 @@ void MusicPlayerAudioProcessorEditor::paint (juce::Graphics& g)
     g.setFont (15.0f);
     g.drawFittedText ("Time", getLocalBounds(), juce::Justification::centredBottom, 1);
     g.setColour(juce::Colours::purple);
-    g.drawText("Level",getWidth()/2-20,210,40,8,juce::Justification::centred);
+    g.drawText("Level",getWidth()/2-20,getHeight()-90,40,8,juce::Justification::centred);
 
 }
 
@@ -108,10 +160,26 @@ void MusicPlayerAudioProcessorEditor::resized()
     // This is generally where you'll want to lay out the positions of any
     // subcomponents in your editor..
 
-    openButton.setBounds(10,10,getWidth()-20,30);
+    auto topWidth = (getWidth()-20) / 3;
+    openButton.setBounds(10,10,topWidth-5,30);
+    queueButton.setBounds(10+topWidth,10,topWidth-5,30);
+    analyseButton.setBounds(10+2*topWidth,10,getWidth()-20-2*topWidth,30);
     playButton.setBounds(10,50,getWidth()-20,30);
     stopButton.setBounds(10,130,getWidth()-20,30);
     pauseButton.setBounds(10,90,getWidth()-20,30);
+    syncButton.setBounds(10,170,120,24);
+    loopInButton.setBounds(140,170,70,24);
+    loopOutButton.setBounds(215,170,70,24);
+    loopButton.setBounds(295,170,getWidth()-305,24);
+    analyserDisplay.setBounds(10,200,getWidth()-20,110);
+
+    auto cueWidth = (getWidth()-20) / (int) cueButtons.size();
+
+    for(int i = 0; i < (int) cueButtons.size(); ++i)
+        cueButtons[(size_t) i].setBounds(10 + i * cueWidth,314,cueWidth-2,20);
+
+    followButton.setBounds(10,340,250,24);
+    automixButton.setBounds(270,340,getWidth()-280,24);
 
     positionSlider.setBounds(10,getHeight()-70,getWidth()-20,50);
     volumeSlider.setBounds(50,getHeight()-120,getWidth()-100,20);
@@ -132,10 +200,40 @@ void MusicPlayerAudioProcessorEditor::openButtonClicked(){
         pauseButton.setEnabled(false);  
         
         positionSlider.setValue(0.0); //snap back to pos 0.0
-        positionSlider.setRange(0.0, audioProcessor.transport.getLengthInSeconds(),1);//set slider range to match audio length
+        positionSlider.setRange(0.0, audioProcessor.transport.getLengthInSeconds(),scrubInterval);//set slider range to match audio length
+
+        for(int i = 0; i < (int) cueButtons.size(); ++i)
+            updateCueButton(i);//a new file starts with no cues
     }
 }
 
+void MusicPlayerAudioProcessorEditor::queueButtonClicked(){
+
+    juce::FileChooser chooser("Add to Queue", juce::File::getSpecialLocation(juce::File::userMusicDirectory));
+
+    if(chooser.browseForMultipleFilesToOpen()){
+
+        for(auto& file : chooser.getResults())
+            audioProcessor.enqueueFile(file);
+
+        updateQueueButton();
+    }
+}
+
+void MusicPlayerAudioProcessorEditor::analyseButtonClicked(){
+
+    juce::FileChooser chooser("Analyse Folder", juce::File::getSpecialLocation(juce::File::userMusicDirectory));
+
+    if(chooser.browseForDirectory())
+        audioProcessor.beatAnalyser.analyseFolder(chooser.getResult());//results land next to each file
+}
+
+void MusicPlayerAudioProcessorEditor::updateQueueButton(){
+
+    auto numQueued = audioProcessor.getQueue().size();
+    queueButton.setButtonText(numQueued > 0 ? "Queue (" + juce::String(numQueued) + ")" : juce::String("Queue..."));
+}
+
 void MusicPlayerAudioProcessorEditor::playButtonClicked(){
 
     stopButton.setEnabled(true);
@@ -176,12 +274,62 @@ void MusicPlayerAudioProcessorEditor::pauseButtonClicked(){
 }
 
 
+void MusicPlayerAudioProcessorEditor::loopInButtonClicked(){
+
+    //loop-out stays where it was. the loop only takes effect once it's after loop-in
+    audioProcessor.setLoopPoints(audioProcessor.transport.getCurrentPosition(), audioProcessor.getLoopOutSeconds());
+}
+
+void MusicPlayerAudioProcessorEditor::loopOutButtonClicked(){
+
+    audioProcessor.setLoopPoints(audioProcessor.getLoopInSeconds(), audioProcessor.transport.getCurrentPosition());
+}
+
+
+void MusicPlayerAudioProcessorEditor::cueButtonClicked(int index){
+
+    if(!audioProcessor.fileLoaded)
+        return;
+
+    if(juce::ModifierKeys::getCurrentModifiers().isShiftDown()){
+        audioProcessor.setHotCue(index, -1.0);
+    }
+    else if(audioProcessor.getHotCue(index) < 0.0){
+        audioProcessor.setHotCue(index, audioProcessor.transport.getCurrentPosition());
+    }
+    else{
+        audioProcessor.triggerHotCue(index);//starts playing if we weren't
+
+        stopButton.setEnabled(true);
+        playButton.setEnabled(false);
+        pauseButton.setEnabled(true);
+        startTimer(1000);
+    }
+
+    updateCueButton(index);
+}
+
+void MusicPlayerAudioProcessorEditor::updateCueButton(int index){
+
+    bool isSet = audioProcessor.getHotCue(index) >= 0.0;
+    cueButtons[(size_t) index].setColour(juce::TextButton::buttonColourId, isSet ? juce::Colours::darkgoldenrod : juce::Colours::darkgrey);
+}
+
+
 void MusicPlayerAudioProcessorEditor:: buttonClicked (juce::Button* button){
 
     if(button == &openButton){
         openButtonClicked();
     }
 
+    else if(button == &queueButton){
+        queueButtonClicked();
+    }
+
+    else if(button == &analyseButton){
+        analyseButtonClicked();
+    }
+
     else if(button == &playButton){
         playButtonClicked();
     }
@@ -195,6 +343,20 @@ void MusicPlayerAudioProcessorEditor:: buttonClicked (juce::Button* button){
         pauseButtonClicked();
     }
 
+    else if(button == &loopInButton){
+        loopInButtonClicked();
+    }
+
+    else if(button == &loopOutButton){
+        loopOutButtonClicked();
+    }
+
+    else{
+        for(int i = 0; i < (int) cueButtons.size(); ++i)
+            if(button == &cueButtons[(size_t) i])
+                cueButtonClicked(i);
+    }
+
 }
 
 
@@ -202,7 +364,10 @@ void MusicPlayerAudioProcessorEditor::sliderValueChanged(juce::Slider* slider){
 
     if(slider == &positionSlider){
 
-        audioProcessor.transport.setPosition(slider->getValue());
+        if(audioProcessor.isScrubbing())
+            audioProcessor.scrubTo(slider->getValue());//no seek until the drag ends
+        else
+            audioProcessor.transport.setPosition(slider->getValue());
     }
 
     else if(slider == &volumeSlider){
@@ -213,8 +378,31 @@ void MusicPlayerAudioProcessorEditor::sliderValueChanged(juce::Slider* slider){
 
 }
 
+void MusicPlayerAudioProcessorEditor::sliderDragStarted(juce::Slider* slider){
+
+    if(slider == &positionSlider)
+        audioProcessor.beginScrub();
+}
+
+void MusicPlayerAudioProcessorEditor::sliderDragEnded(juce::Slider* slider){
+
+    if(slider == &positionSlider)
+        audioProcessor.endScrub();
+}
+
 void MusicPlayerAudioProcessorEditor::timerCallback(){
 
+    //the queue may have moved on to the next file since the last tick
+    auto length = audioProcessor.transport.getLengthInSeconds();
+
+    if(length != positionSlider.getMaximum()){
+        positionSlider.setRange(0.0, length, scrubInterval);
+        updateQueueButton();
+    }
+
+    if(audioProcessor.isScrubbing())
+        return;//the slider is where the mouse has it
+
     positionSlider.setValue(audioProcessor.transport.getCurrentPosition(),juce::dontSendNotification);//make slider update to audio pos (follow)
 
     // above line causes audible clicks on callback (every second)
@@ -9,8 +9,10 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include <memory>
 #include "PluginProcessor.h"
+#include "AnalyserDisplay.h"
 
 //==============================================================================
 /**
@@ -34,26 +36,53 @@ private:
 
     //buttons:
     juce::TextButton openButton;
+    juce::TextButton queueButton;//adds files to play after this one
     juce::TextButton playButton;
     juce::TextButton pauseButton;
     juce::TextButton stopButton;
 
     juce::Slider positionSlider;//follows transport pos and can be used to skip around
+    static constexpr double scrubInterval = 0.1;//seconds. fine enough that a slow drag scrubs smoothly
     juce::Slider volumeSlider;
+    juce::ToggleButton syncButton;//follow the host's transport instead of our own
+    juce::TextButton loopInButton;//set A (or B) to the current position
+    juce::TextButton loopOutButton;
+    juce::ToggleButton loopButton;
+    juce::ToggleButton followButton;//files opened from now on are followed as they're written
+    juce::ToggleButton automixButton;
+    juce::TextButton analyseButton;//beat analysis for a whole folder, ahead of queueing from it
+
+    //click sets an empty cue or jumps to a set one, shift-click clears it
+    std::array<juce::TextButton, MusicPlayerAudioProcessor::maxHotCues> cueButtons;
+
+    AnalyserDisplay analyserDisplay;//spectrum and level meters
 
 
     //MAKE SURE TO DECLARE ATTACHMENTS AFTER THEIR CONTROLS!
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> volSliderAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> syncButtonAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> loopButtonAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> followButtonAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> automixButtonAttachment;
 
 
     void openButtonClicked();
+    void queueButtonClicked();
+    void analyseButtonClicked();
+    void updateQueueButton();
     void playButtonClicked();
     void stopButtonClicked();
     void pauseButtonClicked();
+    void loopInButtonClicked();
+    void loopOutButtonClicked();
+    void cueButtonClicked(int index);
+    void updateCueButton(int index);
 
     void buttonClicked (juce::Button* button) override;
 
     void sliderValueChanged(juce::Slider* slider) override;//essential function. music be included to inherit slider::listener
+    void sliderDragStarted(juce::Slider* slider) override;//dragging positionSlider scrubs
+    void sliderDragEnded(juce::Slider* slider) override;
     void timerCallback() override;//essential function for Timer inherit.
 
     // This reference is provided as a quick way for your editor to
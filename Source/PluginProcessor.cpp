@@ -9,30 +9,115 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 #include <algorithm>
+#include <cmath>
 #include <memory>
 #include <vector>
 
+//==============================================================================
+class MusicPlayerAudioProcessor::PreloadJob  : public juce::ThreadPoolJob
+{
+public:
+    PreloadJob(MusicPlayerAudioProcessor& o, const juce::File& f, int g)
+        : juce::ThreadPoolJob("Preload"), owner(o), file(f), generation(g) {}
+
+    JobStatus runJob() override
+    {
+        preload();
+
+        //only now, so no other preload for this generation can start while this one is still running
+        auto running = generation;
+        owner.preloadingGeneration.compare_exchange_strong(running, -1);
+        return jobHasFinished;
+    }
+
+private:
+    bool isStale()
+    {
+        return shouldExit() || owner.loadGeneration.load() != generation;
+    }
+
+    void preload()
+    {
+        //a cache fill: whatever is playing (here or in another instance) comes first. in short waits,
+        //so a new load or the processor going away never waits for the streams as well
+        for(int waits = 0; waits < 20 && ! isStale(); ++waits)
+            owner.streamScheduler->waitWhileStreamsAreUrgent(100);
+
+        if(isStale())
+            return;
+
+        //opening the file parses its header, preparing it decodes the first few seconds into the read-ahead
+        auto track = owner.createTrack(file, true);//a short file is decoded whole here, off the message thread
+
+        if(track == nullptr || isStale())
+            return;
+
+        owner.playlist.prepareTrack(*track);
+
+        {
+            const juce::ScopedLock sl(owner.trackLock);
+
+            if(owner.loadGeneration.load() != generation)
+                return;//the playlist never saw it, so it's freed right here
+
+            //refused if the sample rate differs: then it's freed here, and playNextInQueue opens the file again at the end
+            if(! owner.playlist.setNextTrack(track.get()))
+                return;
+
+            owner.nextTrack = track;
+        }
+
+        owner.mixPointsPending = true;//setMixPoints is the message thread's, like the playlist's other setters
+    }
+
+    MusicPlayerAudioProcessor& owner;
+    juce::File file;
+    const int generation;
+};
+
 //==============================================================================
 MusicPlayerAudioProcessor::MusicPlayerAudioProcessor() : AudioProcessor(BusesProperties().withOutput("Out", juce::AudioChannelSet::stereo()))
                                                         ,apvts(*this,nullptr,"parameters",createParameters())
+                                                        ,playlist(apvts.getRawParameterValue("QXFADE"))
 
 {
     formatManager.registerBasicFormats();
     transport.addChangeListener(this);
+    playlist.addChangeListener(this);
+    beatAnalyser.addChangeListener(this);
     transport.setPosition(0.0);
 
     state = stopped;//initial state of transport
     
     fileLoaded = false;//used by the pluginEditor. if false will disable all buttons (e.g on startup)
 
-    
+    hotCueSeconds.fill(-1.0);
+
+    hostSyncParameter = apvts.getRawParameterValue("SYNC");
+    volumeParameter = apvts.getRawParameterValue("VOL");
+    rateParameter = apvts.getRawParameterValue("RATE");
+    lastVolume = volumeParameter->load();
 
+    //a plugin doesn't get to mlock its host, but the Standalone may
+    if(wrapperType == wrapperType_Standalone)
+        enableHardening(RealtimeHardening::Options::fromEnvironment());
+
+    startTimerHz(50);
 }
 
 MusicPlayerAudioProcessor::~MusicPlayerAudioProcessor()
 {
+    stopTimer();
+    beatAnalyser.removeChangeListener(this);
+
+    //the jobs use this processor, so they all have to be gone. a preload stops at its next check
+    ++loadGeneration;
+    backgroundJobs.removeAllJobs(true, -1);
 
     transport.setSource(nullptr);
+    playlist.setCurrentTrack(nullptr);
+    currentTrack = nullptr;
+    nextTrack = nullptr;//the read-ahead unregisters from the shared scheduler
     formatReader = nullptr;
 }
 
@@ -105,8 +190,13 @@ void MusicPlayerAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
     // Use this method as the place to do any pre-playback
     // initialisation that you need..
     //
-    transport.prepareToPlay(samplesPerBlock, sampleRate);
-
+    transport.prepareToPlay(samplesPerBlock, sampleRate);//sizes its input for maxRate up front
+    hostSync.prepare(sampleRate);
+    analyser.prepare(sampleRate);
+    equaliser.prepare(sampleRate, samplesPerBlock);
+    scrubber.prepare(sampleRate);
+    limiter.prepare(sampleRate, samplesPerBlock);
+    setLatencySamples(limiter.getLatencySamples());//the limiter's lookahead, so hosts can line us up
 }
 
 void MusicPlayerAudioProcessor::releaseResources()
@@ -145,7 +235,25 @@ bool MusicPlayerAudioProcessor::isBusesLayoutSupported (const BusesLayout& layou
 
 void MusicPlayerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
-     
+    processBlockInternal(buffer);
+}
+
+void MusicPlayerAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processBlockInternal(buffer);
+}
+
+bool MusicPlayerAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
+}
+
+template <typename FloatType>
+void MusicPlayerAudioProcessor::processBlockInternal (juce::AudioBuffer<FloatType>& buffer)
+{
+    if(hardening.isAudioThreadPending())
+        hardening.audioThreadStarted();//first callback after enableHardening, never again
+
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
     
@@ -153,15 +261,113 @@ void MusicPlayerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    auto volume = apvts.getRawParameterValue("VOL");
+    bool hostSynced = hostSyncParameter->load() > 0.5f && fileLoaded;
 
-    
-    transport.getNextAudioBlock(juce::AudioSourceChannelInfo(buffer));
-    transport.setGain(volume->load());
-        
+    if(hostSynced != wasHostSynced){
+        hostSync.reset();//relocate to the host position on the first synced block
+        wasHostSynced = hostSynced;
+    }
+
+    //a negative rate turns the current track round, the transport only ever sees how fast
+    auto rate = hostSynced ? 1.0f : rateParameter->load();
+    playlist.setReverse(rate < 0.0f);
+    transport.setPlayingBackwards(rate < 0.0f);
+    playbackSpeed = juce::jlimit(minimumSpeed, maxRate, std::abs(rate));
+    transport.setSpeed(playbackSpeed);
+
+    if(hostSynced)
+        renderHostSynced(buffer);
+    else if(scrubber.isScrubbing())
+        scrubber.render(buffer);//the transport isn't pulled, so it stays put until endScrub
+    else
+        renderTransport(buffer, 0, buffer.getNumSamples());
+
+    equaliser.process(buffer);
+
+    //volume is ramped per block from the last value so moving VOL doesn't zipper
+    auto volume = volumeParameter->load();
+    buffer.applyGainRamp(0, buffer.getNumSamples(), (FloatType) lastVolume, (FloatType) volume);
+    lastVolume = volume;
+
+    limiter.process(buffer);
+
+    if(analyser.isEnabled())
+        analyser.pushBlock(buffer);
 
 }
 
+template <typename FloatType>
+void MusicPlayerAudioProcessor::renderHostSynced(juce::AudioBuffer<FloatType>& buffer){
+
+    juce::AudioPlayHead::CurrentPositionInfo info;
+    auto* playHead = getPlayHead();
+
+    if(playHead == nullptr || ! playHead->getCurrentPosition(info)){
+        buffer.clear();//nothing to follow (e.g. the standalone app)
+        return;
+    }
+
+    int numSegments = hostSync.update(info, buffer.getNumSamples());
+
+    if(hostSync.needsPreroll())
+        transport.setNextReadPosition(hostSync.getPrerollPosition());//read-ahead starts filling while the host is parked
+
+    if(numSegments == 0){
+        buffer.clear();
+        return;
+    }
+
+    //start() sends a change message, so it's left to the timer. until then these blocks
+    //are silent. it's never stopped either: it just idles while the host is stopped because we
+    //don't pull any audio from it
+    if(! transport.isPlaying())
+        hostNeedsTransport = true;
+
+    for(int i = 0; i < numSegments; ++i){
+
+        const auto& segment = hostSync.getSegment(i);
+
+        if(segment.silent){
+            buffer.clear(segment.startSample, segment.numSamples);
+            continue;
+        }
+
+        if(segment.needsRelocation)
+            transport.setNextReadPosition(segment.timelinePosition);//only costs a seek in the read-ahead buffer
+
+        renderTransport(buffer, segment.startSample, segment.numSamples);
+    }
+}
+
+template <typename FloatType>
+void MusicPlayerAudioProcessor::renderTransport(juce::AudioBuffer<FloatType>& buffer, int startSample, int numSamples){
+
+    //the decode sources only deal in floats; the transport's interpolators widen
+    //them as they write a 64-bit host's block, so there's no scratch copy
+    transport.renderBlock(buffer, startSample, numSamples);
+}
+
+void MusicPlayerAudioProcessor::timerCallback(){
+
+    //a synced transport runs all the time. it's started as SYNC goes on, so the host's first block
+    //already has audio, and again if a block finds it has played off the end. one the user stopped
+    //or paused stays that way
+    bool hostSynced = hostSyncParameter->load() > 0.5f && fileLoaded;
+    bool needed = hostNeedsTransport.exchange(false);
+    bool ranOut = needed && transport.hasStreamFinished() && state == playing;
+
+    if(hostSynced && ! transport.isPlaying() && (ranOut || ! wasHostSyncedOnTimer))
+        transport.start();
+
+    wasHostSyncedOnTimer = hostSynced;
+
+    if(preloadDeferred && preloadingGeneration.load() < 0)
+        preloadNextTrack();
+
+    if(mixPointsPending.exchange(false))
+        updateMixPoints();
+}
+
 //==============================================================================
 bool MusicPlayerAudioProcessor::hasEditor() const
 {
@@ -184,6 +390,22 @@ void MusicPlayerAudioProcessor::getStateInformation (juce::MemoryBlock& destData
 
     std::unique_ptr<juce::XmlElement> xml(state.createXml());//creates an xml from the apvts
     xml->setAttribute("audioFile", currentlyLoadedFile.getFullPathName());//add the audio file to the xml
+    xml->setAttribute("loopIn", loopInSeconds);
+    xml->setAttribute("loopOut", loopOutSeconds);
+
+    juce::StringArray cues;
+
+    for(auto seconds : hotCueSeconds)
+        cues.add(juce::String(seconds));
+
+    xml->setAttribute("hotCues", cues.joinIntoString(","));
+
+    xml->deleteAllChildElementsWithTagName("QUEUE");//an older copy comes back in via replaceState
+    auto* queue = xml->createNewChildElement("QUEUE");
+
+    for(auto& file : playQueue)
+        queue->createNewChildElement("FILE")->setAttribute("path", file.getFullPathName());
+
     copyXmlToBinary(*xml, destData);
 
     
@@ -199,12 +421,28 @@ void MusicPlayerAudioProcessor::setStateInformation (const void* data, int sizeI
     if(xmlState.get() != nullptr){
         if(xmlState->hasTagName(apvts.state.getType())){
             
+            //the queue first, so loading the file can start preloading the head of it
+            clearQueue();
+
+            apvts.replaceState(juce::ValueTree::fromXml(*xmlState));//load all values for the apvts, before the file so it opens the way it was
+
+            if(auto* queue = xmlState->getChildByName("QUEUE"))
+                for(auto* entry = queue->getChildByName("FILE"); entry != nullptr; entry = entry->getNextElementWithTagName("FILE")){
+                    playQueue.add(juce::File::createFileWithoutCheckingPath(entry->getStringAttribute("path")));
+                    beatAnalyser.analyse(playQueue.getLast());
+                }
+
             currentlyLoadedFile = juce::File::createFileWithoutCheckingPath(xmlState->getStringAttribute("audioFile"));
             if(currentlyLoadedFile.existsAsFile()){
                 loadAudioFile(currentlyLoadedFile);
-            }
+                setLoopPoints(xmlState->getDoubleAttribute("loopIn"), xmlState->getDoubleAttribute("loopOut"));
+
+                //the cue audio gets decoded again in the background, the cues work (cold) before that
+                auto cues = juce::StringArray::fromTokens(xmlState->getStringAttribute("hotCues"), ",", "");
 
-            apvts.replaceState(juce::ValueTree::fromXml(*xmlState));//load all values for the apvts
+                for(int i = 0; i < juce::jmin(cues.size(), (int) maxHotCues); ++i)
+                    setHotCue(i, cues[i].getDoubleValue());
+            }
             
         }
         
@@ -214,13 +452,28 @@ void MusicPlayerAudioProcessor::setStateInformation (const void* data, int sizeI
 
 void MusicPlayerAudioProcessor::changeListenerCallback(juce::ChangeBroadcaster *source){
 
-    if(source == &transport){
+    if(source == &playlist){
+        trackAdvanced();
+    }
+
+    else if(source == &beatAnalyser){
+        updateMixPoints();//a grid we were waiting for may have come in
+    }
+
+    else if(source == &transport){
         if(transport.isPlaying())
             changeTransportState(playing);//see changeTransportState below...
         else if(state == stopping)
             changeTransportState(stopped);
         else if(state == pausing)
             changeTransportState(paused);
+        else if(state == playing && transport.hasStreamFinished()){
+            //back at the start of the track: stop there, the queue is only ever played forwards
+            if(transport.isPlayingBackwards())
+                changeTransportState(stopped);
+            else
+                playNextInQueue();
+        }
 
     }
 
@@ -256,29 +509,370 @@ void MusicPlayerAudioProcessor::changeTransportState(transportState newState){
 
 void MusicPlayerAudioProcessor::loadAudioFile(const juce::File& file){
 
+    //anything still decoding is for the old file. nothing waits for the running job:
+    //a preload throws its track away once it sees the generation has moved on
+    {
+        const juce::ScopedLock sl(trackLock);
+        ++loadGeneration;
+    }
+
+    backgroundJobs.removeAllJobs(true, 0);
+
     transport.stop();
     transport.setSource(nullptr);
-    readerSource_ptr = nullptr;
+    playlist.setCurrentTrack(nullptr);
+
+    {
+        const juce::ScopedLock sl(trackLock);
+        currentTrack = nullptr;
+        nextTrack = nullptr;
+    }
 
-    juce::AudioFormatReader* reader = formatManager.createReaderFor(file);
+    loopInSeconds = loopOutSeconds = 0.0;
+    hotCueSeconds.fill(-1.0);
+
+    //the message thread, so it streams even if it's short: a resident clip is decoded whole up front.
+    //short files played from the queue are preloaded, which is where they become resident
+    auto track = createTrack(file, false);
     currentlyLoadedFile = file;
+    beatAnalyser.analyse(file);
+
+    if(track != nullptr){
+        {
+            const juce::ScopedLock sl(trackLock);
+            currentTrack = track;
+        }
 
-    if(reader != nullptr){
-        readerSource_ptr.reset(new juce::AudioFormatReaderSource(reader, true));
-        transport.setSource(readerSource_ptr.get(),0,nullptr,reader->sampleRate);
+        scrubber.setFile(file);
+
+        //playlist -> transport, which only resamples now
+        playlist.setCurrentTrack(track.get());
+        transport.setSource(&playlist, track->sampleRate);
 
         //apvts.state.setProperty("File",currentlyLoadedFile.getFullPathName(),nullptr);
         
 
         fileLoaded = true;
+
+        preloadNextTrack();
+    }
+
+}
+
+std::shared_ptr<TrackChain> MusicPlayerAudioProcessor::createTrack(const juce::File& file, bool decodeShortFiles){
+
+    return TrackChain::create(formatManager, file, *streamScheduler, readAheadSeconds
+            ,apvts.getRawParameterValue("LOOP"), apvts.getRawParameterValue("LOOPXF")
+            ,apvts.getRawParameterValue("GROW")->load() > 0.5f, getStorageFormat(), decodeShortFiles);
+}
+
+SampleStorage::Format MusicPlayerAudioProcessor::getStorageFormat(){
+
+    return (SampleStorage::Format) juce::roundToInt(apvts.getRawParameterValue("STORAGE")->load());
+}
+
+void MusicPlayerAudioProcessor::enqueueFile(const juce::File& file){
+
+    playQueue.add(file);
+    beatAnalyser.analyse(file);
+    preloadNextTrack();
+}
+
+void MusicPlayerAudioProcessor::beginScrub(){
+
+    if(fileLoaded)
+        scrubber.begin(transport.getCurrentPosition());
+}
+
+void MusicPlayerAudioProcessor::scrubTo(double seconds){
+
+    scrubber.moveTo(juce::jlimit(0.0, transport.getLengthInSeconds(), seconds));
+}
+
+void MusicPlayerAudioProcessor::endScrub(){
+
+    if(! scrubber.isScrubbing())
+        return;
+
+    scrubber.end();
+    transport.setPosition(scrubber.getTargetSeconds());//the one real seek, to wherever the drag let go
+}
+
+void MusicPlayerAudioProcessor::enableHardening(const RealtimeHardening::Options& options){
+
+    if(! options.enabled || hardening.isEnabled())
+        return;
+
+    hardening.apply(options);
+    //shared with any other instance in the process, which is harmless: the settings are the same
+    auto ioThreads = streamScheduler->getThreadIds();
+
+    for(int i = 0; i < ioThreads.size(); ++i)
+        hardening.addIoThread("io" + juce::String(i + 1), ioThreads[i]);
+
+    //the pool's thread can only be reached from inside it
+    backgroundJobs.addJob([this]{ hardening.addIoThread("preload", juce::Thread::getCurrentThreadId()); });
+
+    juce::Logger::writeToLog("MusicPlayer: " + hardening.getReport());//the audio thread shows up once it has run
+}
+
+juce::String MusicPlayerAudioProcessor::getStreamReport() const{
+
+    return streamScheduler->getReport();
+}
+
+double MusicPlayerAudioProcessor::getBufferedSeconds() const{
+
+    std::shared_ptr<TrackChain> track;
+
+    {
+        const juce::ScopedLock sl(trackLock);//precisionbench asks from the control server's thread
+        track = currentTrack;
     }
 
+    if(track == nullptr)
+        return 0.0;
+
+    if(track->readAheadSource == nullptr){
+        auto* source = track->getOutput();
+        return (source->getTotalLength() - source->getNextReadPosition()) / track->sampleRate;//all in memory
+    }
+
+    return track->readAheadSource->getNumBufferedSamples() / track->sampleRate;
+}
+
+void MusicPlayerAudioProcessor::clearQueue(){
+
+    playQueue.clear();
+
+    //all at once, so a preload finishing now can't slip its track in after the playlist has let go
+    const juce::ScopedLock sl(trackLock);
+    ++loadGeneration;//a preload half way through throws its track away
+    playlist.setNextTrack(nullptr);
+    nextTrack = nullptr;
+}
+
+void MusicPlayerAudioProcessor::preloadNextTrack(){
+
+    preloadDeferred = false;
+
+    if(currentTrack == nullptr || playQueue.isEmpty())
+        return;
+
+    {
+        const juce::ScopedLock sl(trackLock);
+
+        if(nextTrack != nullptr)
+            return;
+    }
+
+    //one preload per generation. one left over from an older generation may still be running, but it
+    //won't keep its track, so it doesn't hold this one up
+    auto generation = loadGeneration.load();
+
+    if(preloadingGeneration.load() == generation){
+        preloadDeferred = true;//e.g. a hand-off just before it finished
+        return;
+    }
+
+    preloadingGeneration = generation;
+    backgroundJobs.addJob(new PreloadJob(*this, playQueue.getFirst(), generation), true);
+}
+
+void MusicPlayerAudioProcessor::updateMixPoints(){
+
+    std::shared_ptr<TrackChain> current, next;
+
+    {
+        const juce::ScopedLock sl(trackLock);
+        current = currentTrack;
+        next = nextTrack;
+    }
+
+    if(current == nullptr || next == nullptr)
+        return;
+
+    BeatGrid outgoing, incoming;
+
+    if(apvts.getRawParameterValue("AUTOMIX")->load() < 0.5f
+        || ! beatAnalyser.getGrid(current->file, outgoing) || ! beatAnalyser.getGrid(next->file, incoming)){
+        playlist.setMixPoints(current.get(), next.get(), -1, 0, -1);//plain end to start
+        return;
+    }
+
+    //the fade is a whole number of the outgoing track's bars, ending on its last downbeat.
+    //the next track comes in on its first downbeat as the fade starts, so downbeats line
+    //up, although they drift apart over the fade by as much as the tempos differ
+    auto rate = current->sampleRate;
+    auto barSeconds = outgoing.getBarSeconds();
+    auto fadeBars = std::round(apvts.getRawParameterValue("QXFADE")->load() / barSeconds);
+    auto outSeconds = outgoing.getDownbeatAtOrBefore((double) current->getOutput()->getTotalLength() / rate);
+    auto fadeSeconds = fadeBars * barSeconds;
+
+    if(outSeconds - fadeSeconds <= 0.0){
+        playlist.setMixPoints(current.get(), next.get(), -1, 0, -1);
+        return;
+    }
+
+    playlist.setMixPoints(current.get(), next.get(), std::llround(outSeconds * rate)
+            ,std::llround(juce::jmax(0.0, incoming.firstDownbeatSeconds) * rate)
+            ,(int) std::llround(fadeSeconds * rate));
+}
+
+void MusicPlayerAudioProcessor::trackAdvanced(){
+
+    {
+        const juce::ScopedLock sl(trackLock);
+
+        if(nextTrack == nullptr || playlist.getCurrentTrack() != nextTrack.get())
+            return;
+
+        //the old track is freed here. the audio thread let go of it at the hand-off
+        currentTrack = std::move(nextTrack);
+        nextTrack = nullptr;
+    }
+
+    currentlyLoadedFile = currentTrack->file;
+    scrubber.setFile(currentlyLoadedFile);
+    playQueue.remove(0);
+
+    //loop and cues belonged to the previous file
+    loopInSeconds = loopOutSeconds = 0.0;
+    hotCueSeconds.fill(-1.0);
+
+    preloadNextTrack();
+}
+
+void MusicPlayerAudioProcessor::playNextInQueue(){
+
+    if(playQueue.isEmpty())
+        return;
+
+    auto file = playQueue.removeAndReturn(0);
+
+    loadAudioFile(file);
+
+    if(fileLoaded)
+        changeTransportState(starting);
+}
+
+void MusicPlayerAudioProcessor::setLoopPoints(double inSeconds, double outSeconds){
+
+    loopInSeconds = inSeconds;
+    loopOutSeconds = outSeconds;
+
+    auto track = currentTrack;
+
+    if(track == nullptr)
+        return;
+
+    int generation;
+
+    {
+        const juce::ScopedLock sl(trackLock);
+        generation = ++loopGeneration;
+
+        if(outSeconds <= inSeconds){
+            track->loopSource->setRegion(nullptr);//not a usable loop (yet)
+            return;
+        }
+    }
+
+    //the job keeps the track alive, even if the playlist has moved on by the time it's done
+    auto format = getStorageFormat();
+
+    backgroundJobs.addJob([this, track, inSeconds, outSeconds, format, generation]{
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(track->file));
+
+        if(reader == nullptr)
+            return;
+
+        auto loopIn = (juce::int64) (inSeconds * reader->sampleRate);
+        auto loopOut = (juce::int64) (outSeconds * reader->sampleRate);
+        auto region = LoopingAudioSource::decodeRegion(*reader, loopIn, loopOut, format);
+
+        //checked and installed in one go, so the points can't be moved or cleared in between
+        const juce::ScopedLock sl(trackLock);
+
+        if(loopGeneration == generation)
+            track->loopSource->setRegion(std::move(region));
+    });
+}
+
+void MusicPlayerAudioProcessor::setHotCue(int index, double seconds){
+
+    jassert(juce::isPositiveAndBelow(index, (int) maxHotCues));
+
+    hotCueSeconds[(size_t) index] = seconds;
+
+    auto track = currentTrack;
+
+    if(track == nullptr)
+        return;
+
+    int generation;
+
+    {
+        const juce::ScopedLock sl(trackLock);
+        generation = ++hotCueGenerations[(size_t) index];
+        track->hotCueSource->setCueAudio(index, nullptr);
+    }
+
+    if(seconds < 0.0)
+        return;
+
+    auto format = getStorageFormat();
+
+    backgroundJobs.addJob([this, track, index, seconds, format, generation]{
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(track->file));
+
+        if(reader == nullptr)
+            return;
+
+        auto audio = HotCueAudioSource::decodeCue(*reader, (juce::int64) (seconds * reader->sampleRate), format);
+
+        //as in setLoopPoints: a cue moved or cleared meanwhile keeps what it has now
+        const juce::ScopedLock sl(trackLock);
+
+        if(hotCueGenerations[(size_t) index] == generation)
+            track->hotCueSource->setCueAudio(index, std::move(audio));
+    });
+}
+
+void MusicPlayerAudioProcessor::triggerHotCue(int index){
+
+    auto seconds = hotCueSeconds[(size_t) index];
+
+    if(seconds < 0.0 || ! fileLoaded)
+        return;
+
+    //lands in the cue's decoded audio, so the next block already plays from it
+    transport.setPosition(seconds);
+
+    if(state != playing && state != starting)
+        changeTransportState(starting);
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout MusicPlayerAudioProcessor::createParameters(){
         
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
     params.push_back(std::make_unique<juce::AudioParameterFloat>("VOL","Vol",0.0f,1.0f,0.5f));
+    params.push_back(std::make_unique<juce::AudioParameterBool>("SYNC","Host Sync",false));//follow the host playhead
+    params.push_back(std::make_unique<juce::AudioParameterBool>("LOOP","Loop",false));//A-B loop on/off
+    params.push_back(std::make_unique<juce::AudioParameterFloat>("LOOPXF","Loop Crossfade",
+            juce::NormalisableRange<float>(0.0f,(float) (LoopingAudioSource::maxCrossfadeSeconds * 1000.0),1.0f),10.0f));//ms
+    params.push_back(std::make_unique<juce::AudioParameterFloat>("QXFADE","Queue Crossfade",
+            juce::NormalisableRange<float>(0.0f,PlaylistAudioSource::maxCrossfadeSeconds,0.1f),0.0f));//seconds, 0 = gapless
+    params.push_back(std::make_unique<juce::AudioParameterBool>("GROW","Follow Growing Files",false));//WAVs opened while still being written keep growing
+    params.push_back(std::make_unique<juce::AudioParameterBool>("AUTOMIX","Beat-Matched Automix",false));//queue transitions on downbeats, fades in whole bars
+    params.push_back(std::make_unique<juce::AudioParameterChoice>("STORAGE","Resident Audio Storage",
+            juce::StringArray{"32-bit float","16-bit","Half float","Compressed 16-bit"},0));//in SampleStorage::Format order
+    EqualiserChain::addParameters(params);//HP, EQ1..EQ10, LP
+    TruePeakLimiter::addParameters(params);//LIMIT, CEILING
+    params.push_back(std::make_unique<juce::AudioParameterFloat>("RATE","Playback Rate",
+            juce::NormalisableRange<float>(-maxRate,maxRate,0.01f),1.0f));//below zero plays backwards
 
     
     return {params.begin(), params.end()};
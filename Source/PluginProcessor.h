@@ -9,12 +9,26 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include <memory>
+#include "HostTransportSync.h"
+#include "AudioAnalyser.h"
+#include "BeatAnalyser.h"
+#include "EqualiserChain.h"
+#include "TruePeakLimiter.h"
+#include "RealtimeHardening.h"
+#include "ScrubEngine.h"
+#include "LoopingAudioSource.h"
+#include "HotCueAudioSource.h"
+#include "PlaylistAudioSource.h"
+#include "RealtimeTransportSource.h"
+#include "TrackChain.h"
 //==============================================================================
 /**
 */
 class MusicPlayerAudioProcessor  : public juce::AudioProcessor,
-                                   public juce::ChangeListener
+                                   public juce::ChangeListener,
+                                   private juce::Timer
 {
 public:
     //==============================================================================
@@ -30,6 +44,8 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -70,12 +86,32 @@ public:
     void changeTransportState(transportState newState);
     void chooseAudioFile();
     void loadAudioFile(const juce::File& file);
+    void setLoopPoints(double inSeconds, double outSeconds);//A-B loop, decodes the loop start in the background
+    double getLoopInSeconds() const { return loopInSeconds; }
+    double getLoopOutSeconds() const { return loopOutSeconds; }
+
+    static constexpr int maxHotCues = HotCueAudioSource::maxCues;
+    void setHotCue(int index, double seconds);//a negative time clears the cue
+    double getHotCue(int index) const { return hotCueSeconds[(size_t) index]; }
+    void triggerHotCue(int index);//jump to the cue and play
+
+    void enqueueFile(const juce::File& file);//plays after the current file, gaplessly where it can
+    void clearQueue();
+    const juce::Array<juce::File>& getQueue() const { return playQueue; }
+    double getBufferedSeconds() const;//decoded and waiting in the current track's read-ahead
+    juce::String getStreamReport() const;//the shared scheduler's threads, and starvation stats for every stream
+
+    //while the position slider is dragged: grains from around the drag position, then one seek at the end
+    void beginScrub();
+    void scrubTo(double seconds);
+    void endScrub();
+    bool isScrubbing() const { return scrubber.isScrubbing(); }
     juce::AudioProcessorValueTreeState::ParameterLayout createParameters();
 
-    juce::AudioTransportSource transport;
+    //the playlist at the device's rate and RATE's speed, without locks on the audio thread
+    RealtimeTransportSource transport{maxRate, [this]{ streamScheduler->wake(); }};
     juce::File currentlyLoadedFile;
     bool fileLoaded;
-    std::unique_ptr<juce::AudioFormatReaderSource> readerSource_ptr; 
     juce::AudioFormatManager formatManager; //This class contains a list of audio formats (such as WAV, AIFF,
    // Ogg Vorbis, and so on) and can create suitable objects for reading audio data from these formats.
 
@@ -83,9 +119,72 @@ public:
 
     juce::AudioProcessorValueTreeState apvts;
 
+    AudioAnalyser analyser;//meters and spectrum, only running while an editor is open
+    BeatAnalyser beatAnalyser{formatManager};//bpm and beat grids for automix, in the background
+    TruePeakLimiter limiter{apvts};//last stage of processBlock, its gain reduction is metered
+    RealtimeHardening hardening;//opt-in, Standalone and headless only
+
+    void enableHardening(const RealtimeHardening::Options& options);//locks memory, then the I/O threads and the audio thread
+
 private:
 
-       
+    //float and double hosts share the same code, only pulling from the transport differs
+    template <typename FloatType> void processBlockInternal(juce::AudioBuffer<FloatType>& buffer);
+    template <typename FloatType> void renderHostSynced(juce::AudioBuffer<FloatType>& buffer);//follows the DAW timeline instead of our own transport
+    template <typename FloatType> void renderTransport(juce::AudioBuffer<FloatType>& buffer, int startSample, int numSamples);
+    void timerCallback() override;//message thread: whatever the audio thread asked for
+
+    std::atomic<float>* volumeParameter{nullptr};
+    float lastVolume{0.5f};
+
+    //RATE: speed through the transport's resampler, direction by turning the current track round
+    std::atomic<float>* rateParameter{nullptr};
+    float playbackSpeed{1.0f};//audio thread
+    static constexpr float maxRate = 2.0f;
+    static constexpr float minimumSpeed = 0.25f;//slower than this, either way, is held here
+    EqualiserChain equaliser{apvts};//insert chain between the transport and the volume
+
+    juce::SharedResourcePointer<StreamScheduler> streamScheduler;//decodes ahead of every playhead in the process, most urgent first
+    static constexpr double readAheadSeconds = 2.0;
+    ScrubEngine scrubber{formatManager, *streamScheduler};//replaces the transport's output while scrubbing
+
+    juce::ThreadPool backgroundJobs{1};//pre-decoding that mustn't hold up the message thread
+
+    std::shared_ptr<TrackChain> createTrack(const juce::File& file, bool decodeShortFiles);//only background threads decode
+    SampleStorage::Format getStorageFormat();//for resident clips, loop heads and cues
+    void preloadNextTrack();//opens the head of the queue and fills its read-ahead
+    void trackAdvanced();//the playlist has moved on to nextTrack
+    void playNextInQueue();//when the next track couldn't follow on gaplessly
+    void updateMixPoints();//lines the next track's downbeats up with the current one's, if automix is on
+
+    PlaylistAudioSource playlist;//what the transport plays: the current track, then the next
+
+    //currentTrack only changes on the message thread, nextTrack is also set by the preload job
+    juce::CriticalSection trackLock;
+    std::shared_ptr<TrackChain> currentTrack;
+    std::shared_ptr<TrackChain> nextTrack;
+
+    //bumped (under trackLock) whenever a preload in flight stops being wanted: a new file, the queue
+    //cleared. a preload only keeps its track if the generation it started in is still current
+    class PreloadJob;
+    std::atomic<int> loadGeneration{0};
+    std::atomic<int> preloadingGeneration{-1};//the generation a preload job is running for, until it ends
+    bool preloadDeferred{false};//refused while that job ran, the timer tries again
+    std::atomic<bool> mixPointsPending{false};//a preload put a next track in, the timer lines it up
+
+    juce::Array<juce::File> playQueue;//files to play after currentlyLoadedFile
+
+    double loopInSeconds{0.0};
+    double loopOutSeconds{0.0};
+    int loopGeneration{0};//under trackLock: bumped by setLoopPoints, a decode for older points throws its region away
+    std::array<double, HotCueAudioSource::maxCues> hotCueSeconds;
+    std::array<int, HotCueAudioSource::maxCues> hotCueGenerations{};//like loopGeneration, one per cue
+
+    HostTransportSync hostSync;
+    std::atomic<float>* hostSyncParameter{nullptr};
+    bool wasHostSynced{false};
+    std::atomic<bool> hostNeedsTransport{false};//a synced block found the transport stopped, the timer starts it
+    bool wasHostSyncedOnTimer{false};
 
     juce::AudioFormatReader* formatReader{nullptr};
 
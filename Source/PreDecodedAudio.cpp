@@ -0,0 +1,38 @@
+/*
+  ==============================================================================
+
+    PreDecodedAudio.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "PreDecodedAudio.h"
+
+int PreDecodedAudio::read(juce::AudioBuffer<float>& dest, int destStartSample, int numSamples, juce::int64 position) const
+{
+    if(! contains(position))
+        return 0;
+
+    auto numThisTime = (int) juce::jmin((juce::int64) numSamples, getEndPosition() - position);
+    audio.read(dest, destStartSample, (int) (position - startPosition), numThisTime);
+
+    return numThisTime;
+}
+
+std::unique_ptr<PreDecodedAudio> PreDecodedAudio::decode(juce::AudioFormatReader& reader, juce::int64 start, juce::int64 end,
+                                                         SampleStorage::Format format)
+{
+    auto decoded = std::make_unique<PreDecodedAudio>();
+
+    decoded->startPosition = juce::jmax((juce::int64) 0, start);
+    end = juce::jmin(reader.lengthInSamples, end);
+
+    auto numSamples = (int) juce::jmax((juce::int64) 0, end - decoded->startPosition);
+
+    juce::AudioBuffer<float> samples(2, numSamples);
+    reader.read(&samples, 0, numSamples, decoded->startPosition, true, true);
+    decoded->audio.store(samples, 0, numSamples, format);
+
+    return decoded;
+}
@@ -0,0 +1,41 @@
+/*
+  ==============================================================================
+
+    PreDecodedAudio.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleStorage.h"
+#include <memory>
+
+//==============================================================================
+/**
+    A stretch of a file decoded into memory ahead of time, so playback can jump
+    into it without waiting on the decoder. The loop start and hot cues keep one
+    of these each, and play from it while the read-ahead buffer catches up from
+    its end.
+
+    Always two channels: a mono file goes into both, as AudioFormatReaderSource does.
+    With lots of cues resident, a compact storage format keeps the memory down.
+*/
+struct PreDecodedAudio
+{
+    juce::int64 startPosition = 0;//file position of the first sample in audio
+    SampleStorage audio;
+
+    juce::int64 getEndPosition() const              { return startPosition + audio.getNumSamples(); }
+    bool contains (juce::int64 position) const      { return position >= startPosition && position < getEndPosition(); }
+
+    /** Copies from position onwards into dest, stopping at the end of what was decoded.
+        Returns how many samples were copied. */
+    int read (juce::AudioBuffer<float>& dest, int destStartSample, int numSamples, juce::int64 position) const;
+
+    /** Decodes [start, end) of the reader. Background threads only, never the audio thread. */
+    static std::unique_ptr<PreDecodedAudio> decode (juce::AudioFormatReader& reader, juce::int64 start, juce::int64 end,
+                                                    SampleStorage::Format format = SampleStorage::Format::float32);
+};
@@ -0,0 +1,303 @@
+/*
+  ==============================================================================
+
+    ReadAheadAudioSource.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ReadAheadAudioSource.h"
+#include <algorithm>
+
+ReadAheadAudioSource::ReadAheadAudioSource(juce::PositionableAudioSource* s, StreamScheduler& sch,
+                                           int samplesToBuffer, int channels)
+    : source(s), scheduler(sch),
+      numberOfSamplesToBuffer(juce::jmax(1024, samplesToBuffer)),
+      numberOfChannels(channels)
+{
+    jassert(source != nullptr);
+    knownLength = source->getTotalLength();
+}
+
+ReadAheadAudioSource::~ReadAheadAudioSource()
+{
+    scheduler.removeStream(this);
+}
+
+void ReadAheadAudioSource::sourceHasGrown()
+{
+    scheduler.wake();
+}
+
+void ReadAheadAudioSource::setReverse(bool shouldReverse)
+{
+    reversed = shouldReverse;
+
+    //as with seeks, the workers find out on their own when the audio thread turns us round
+    if(juce::MessageManager::existsAndIsCurrentThread())
+        scheduler.wake();
+}
+
+int ReadAheadAudioSource::getNumBufferedSamples() const
+{
+    const juce::SpinLock::ScopedLockType sl(bufferLock);
+
+    auto position = nextPlayPos.load();
+
+    if(position < bufferValidStart || position > bufferValidEnd)
+        return 0;
+
+    return (int) (reversed.load() ? position - bufferValidStart : bufferValidEnd - position);
+}
+
+//==============================================================================
+void ReadAheadAudioSource::prepareToPlay(int samplesPerBlockExpected, double newSampleRate)
+{
+    auto bufferSizeNeeded = juce::jmax(samplesPerBlockExpected * 2, numberOfSamplesToBuffer);
+
+    if(isPrepared && bufferSizeNeeded == buffer.getNumSamples())
+        return;
+
+    scheduler.removeStream(this);//nothing may be writing into the buffer while it's resized
+
+    sampleRate = newSampleRate;
+    source->prepareToPlay(samplesPerBlockExpected, newSampleRate);
+    buffer.setSize(numberOfChannels, bufferSizeNeeded);
+    buffer.clear();
+
+    {
+        const juce::SpinLock::ScopedLockType sl(bufferLock);
+        bufferValidStart = bufferValidEnd = nextPlayPos.load();
+    }
+
+    isPrepared = true;
+    scheduler.addStream(this);
+
+    //fill some of it before returning, so playback doesn't start on an empty buffer
+    auto target = juce::jmin((juce::int64) bufferSizeNeeded / 2, reversed.load() ? nextPlayPos.load() : knownLength.load() - nextPlayPos.load());
+
+    for(int tries = 0; tries < 200 && getNumBufferedSamples() < target; ++tries){
+        scheduler.wake();
+        juce::Thread::sleep(5);
+    }
+}
+
+void ReadAheadAudioSource::releaseResources()
+{
+    isPrepared = false;
+    scheduler.removeStream(this);
+    buffer.setSize(numberOfChannels, 0);
+    source->releaseResources();
+}
+
+void ReadAheadAudioSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& info)
+{
+    const juce::SpinLock::ScopedLockType sl(bufferLock);
+
+    lastPulledAt.store(juce::Time::getMillisecondCounter(), std::memory_order_relaxed);
+
+    auto start = nextPlayPos.load();
+    auto numToAdvance = info.numSamples;
+    bool backwards = reversed.load(std::memory_order_relaxed);
+
+    //waiting at the write head: play silence but don't move past audio that isn't there yet
+    if(followGrowingSource && ! backwards)
+        numToAdvance = (int) juce::jlimit((juce::int64) 0, (juce::int64) numToAdvance, knownLength.load() - start);
+
+    //the file positions this block covers. backwards it's the ones just below the play position
+    auto blockStart = backwards ? start - numToAdvance : start;
+    auto end = backwards ? start : start + numToAdvance;
+    auto validStart = juce::jlimit(blockStart, end, bufferValidStart);
+    auto validEnd = juce::jlimit(validStart, end, bufferValidEnd);
+    auto bufferSize = buffer.getNumSamples();
+
+    //short of what was asked for, and not because the file ends (or starts) here
+    auto available = juce::jmin(end, knownLength.load()) - juce::jmax((juce::int64) 0, blockStart);
+
+    if(validEnd - validStart < available)
+        underruns.fetch_add(1, std::memory_order_relaxed);
+
+    if(validStart == validEnd || bufferSize == 0){
+        info.clearActiveBufferRegion();//not decoded yet, an underrun
+    }
+    else{
+        auto offset = (int) (validStart - blockStart);
+        auto numValid = (int) (validEnd - validStart);
+
+        if(offset > 0)
+            info.buffer->clear(info.startSample, offset);
+
+        if(offset + numValid < info.numSamples)
+            info.buffer->clear(info.startSample + offset + numValid, info.numSamples - offset - numValid);
+
+        auto ringIndex = (int) (validStart % bufferSize);
+        auto firstPart = juce::jmin(numValid, bufferSize - ringIndex);
+        auto numChannels = juce::jmin(info.buffer->getNumChannels(), buffer.getNumChannels());
+
+        for(int channel = 0; channel < numChannels; ++channel){
+            info.buffer->copyFrom(channel, info.startSample + offset, buffer, channel, ringIndex, firstPart);
+
+            if(numValid > firstPart)
+                info.buffer->copyFrom(channel, info.startSample + offset + firstPart, buffer, channel, 0, numValid - firstPart);
+        }
+
+        for(int channel = numChannels; channel < info.buffer->getNumChannels(); ++channel)
+            info.buffer->clear(channel, info.startSample + offset, numValid);
+    }
+
+    if(backwards){
+
+        //copied out in file order, so turn it round
+        for(int channel = 0; channel < info.buffer->getNumChannels(); ++channel){
+            auto* samples = info.buffer->getWritePointer(channel, info.startSample);
+            std::reverse(samples, samples + info.numSamples);
+        }
+
+        nextPlayPos = juce::jmax((juce::int64) 0, blockStart);
+    }
+    else{
+        nextPlayPos = end;
+    }
+}
+
+//==============================================================================
+double ReadAheadAudioSource::getSecondsUntilUnderrun() const
+{
+    return getNumBufferedSamples() / juce::jmax(1.0, sampleRate.load());
+}
+
+bool ReadAheadAudioSource::isActive() const
+{
+    return juce::Time::getMillisecondCounter() - lastPulledAt.load(std::memory_order_relaxed) < 250;
+}
+
+bool ReadAheadAudioSource::hasWorkToDo() const
+{
+    auto bufferSize = buffer.getNumSamples();
+
+    if(bufferSize == 0)
+        return false;
+
+    auto length = source->getTotalLength();//may have grown since the last chunk
+    const juce::SpinLock::ScopedLockType sl(bufferLock);
+
+    auto playPos = juce::jmax((juce::int64) 0, nextPlayPos.load());
+    auto history = bufferSize / 4;
+
+    if(reversed.load())
+        playPos = juce::jmin(playPos, length);//turned round past the end, start reading from the end
+
+    if(playPos < bufferValidStart || playPos > bufferValidEnd)
+        return true;//a seek
+
+    //same limits as readNextChunk
+    if(reversed.load())
+        return bufferValidStart > juce::jmax((juce::int64) 0, juce::jmin(bufferValidEnd, playPos + history) - (bufferSize - 4));
+
+    return bufferValidEnd < juce::jmin(juce::jmax(bufferValidStart, playPos - history) + bufferSize - 4, length);
+}
+
+bool ReadAheadAudioSource::readNextChunk()
+{
+    const int maxChunkSize = 2048;
+    auto bufferSize = buffer.getNumSamples();
+
+    if(bufferSize == 0)
+        return false;
+
+    auto length = source->getTotalLength();
+    knownLength = length;
+
+    auto history = bufferSize / 4;//kept behind the play position, for turning round
+    bool backwards = reversed.load();
+    juce::int64 sectionStart, sectionEnd;
+
+    {
+        const juce::SpinLock::ScopedLockType sl(bufferLock);
+
+        auto playPos = juce::jmax((juce::int64) 0, nextPlayPos.load());
+
+        if(backwards)
+            playPos = juce::jmin(playPos, length);//turned round past the end, start reading from the end
+
+        if(playPos < bufferValidStart || playPos > bufferValidEnd)
+            bufferValidStart = bufferValidEnd = playPos;//a seek, start again from there
+        else if(backwards)
+            bufferValidEnd = juce::jmin(bufferValidEnd, playPos + history);//forget most of what has been played
+        else
+            bufferValidStart = juce::jmax(bufferValidStart, playPos - history);
+
+        if(backwards){
+
+            //down to a chunk boundary, so the next chunk is a whole one
+            auto wantedStart = juce::jmax((juce::int64) 0, bufferValidEnd - (bufferSize - 4));
+
+            sectionEnd = bufferValidStart;
+            sectionStart = juce::jmax(wantedStart, ((sectionEnd - 1) / reverseChunkSize) * reverseChunkSize);
+        }
+        else{
+
+            //the source may still be growing, so never buffer past what it has now
+            auto wantedEnd = juce::jmin(bufferValidStart + bufferSize - 4, length);
+
+            sectionStart = bufferValidEnd;
+            sectionEnd = juce::jmin(wantedEnd, sectionStart + maxChunkSize);
+        }
+    }
+
+    if(sectionEnd <= sectionStart)
+        return false;
+
+    //outside the lock: these ring slots are all outside what the audio thread may read
+    auto numSamples = (int) (sectionEnd - sectionStart);
+    auto ringIndex = (int) (sectionStart % bufferSize);
+    auto firstPart = juce::jmin(numSamples, bufferSize - ringIndex);
+
+    source->setNextReadPosition(sectionStart);
+    source->getNextAudioBlock(juce::AudioSourceChannelInfo(&buffer, ringIndex, firstPart));
+
+    if(numSamples > firstPart)
+        source->getNextAudioBlock(juce::AudioSourceChannelInfo(&buffer, 0, numSamples - firstPart));
+
+    {
+        const juce::SpinLock::ScopedLockType sl(bufferLock);
+
+        if(backwards && bufferValidStart == sectionEnd)
+            bufferValidStart = sectionStart;
+        else if(! backwards && bufferValidEnd == sectionStart)
+            bufferValidEnd = sectionEnd;
+    }
+
+    return true;
+}
+
+//==============================================================================
+void ReadAheadAudioSource::setNextReadPosition(juce::int64 newPosition)
+{
+    nextPlayPos = newPosition;
+
+    //no wake() from here: every seek comes from the audio thread (the transport makes them there) or
+    //under the playlist's SpinLock, and neither may wait on the scheduler's lock. the transport wakes
+    //the workers afterwards, and otherwise they poll often enough to find seeks on their own
+}
+
+juce::int64 ReadAheadAudioSource::getNextReadPosition() const
+{
+    return nextPlayPos.load();
+}
+
+juce::int64 ReadAheadAudioSource::getTotalLength() const
+{
+    return knownLength.load();
+}
+
+bool ReadAheadAudioSource::isLooping() const
+{
+    return false;
+}
+
+void ReadAheadAudioSource::setLooping(bool)
+{
+    //looping happens above us (LoopingAudioSource), never down at the file
+}
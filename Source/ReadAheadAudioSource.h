@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    ReadAheadAudioSource.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include "StreamScheduler.h"
+
+//==============================================================================
+/**
+    Decodes ahead of the play position on the shared StreamScheduler's threads,
+    much like juce::BufferingAudioSource, so the audio thread only ever copies out
+    of memory. Its deadline there is however much is decoded in front of the play
+    position.
+
+    The difference is that it never buffers past the source's current length. For
+    a file that is still being written, that means nothing past the write head is
+    cached as silence: once the file grows, the new audio is picked up like any
+    other. With followGrowingSource set, playback also waits at the end of the data
+    that's there (playing silence) instead of running off the end and stopping.
+
+    Reversed, it plays from the play position downwards and reads ahead below it,
+    reverseChunkSize samples at a time on chunk boundaries so a compressed reader
+    seeks once a chunk rather than once a block. Chunks are kept in file order and
+    each block is turned round in place on the way out. In either direction a
+    quarter of the buffer is kept behind the play position, so turning round
+    plays from memory while the first chunk the other way is read.
+*/
+class ReadAheadAudioSource  : public juce::PositionableAudioSource,
+                              private StreamScheduler::Stream
+{
+public:
+    /** The source isn't owned. */
+    ReadAheadAudioSource (juce::PositionableAudioSource* source, StreamScheduler& scheduler,
+                          int numberOfSamplesToBuffer, int numberOfChannels = 2);
+    ~ReadAheadAudioSource() override;
+
+    void setFollowsGrowingSource (bool shouldFollow)    { followGrowingSource = shouldFollow; }
+
+    /** Any thread, including the audio thread. Growing sources only follow forwards. */
+    void setReverse (bool shouldReverse);
+    bool isReversed() const noexcept                    { return reversed.load(); }
+
+    static constexpr int reverseChunkSize = 16384;
+
+    /** What the scheduler's report calls it, usually the file name. */
+    void setStreamName (const juce::String& name)       { streamName = name; }
+
+    /** Wakes the scheduler, e.g. because the file just grew. */
+    void sourceHasGrown();
+
+    /** How much is decoded and waiting from the play position onwards. */
+    int getNumBufferedSamples() const;
+
+    //==============================================================================
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock (const juce::AudioSourceChannelInfo& info) override;
+
+    void setNextReadPosition (juce::int64 newPosition) override;
+    juce::int64 getNextReadPosition() const override;
+    juce::int64 getTotalLength() const override;
+    bool isLooping() const override;
+    void setLooping (bool shouldLoop) override;
+
+private:
+    double getSecondsUntilUnderrun() const override;
+    bool isActive() const override;
+    bool hasWorkToDo() const override;
+    bool readNextChunk() override;
+    juce::String getStreamName() const override         { return streamName; }
+
+    juce::PositionableAudioSource* source;
+    StreamScheduler& scheduler;
+    juce::String streamName;
+    const int numberOfSamplesToBuffer;
+    const int numberOfChannels;
+
+    juce::AudioBuffer<float> buffer;//a ring, indexed by file position modulo its length
+
+    //the valid range only moves on a scheduler thread. the audio thread takes the
+    //lock just long enough to copy out of the part that's ready
+    juce::SpinLock bufferLock;
+    juce::int64 bufferValidStart = 0;
+    juce::int64 bufferValidEnd = 0;
+    std::atomic<juce::int64> nextPlayPos{0};
+    std::atomic<juce::int64> knownLength{0};//the source's length, as of the last chunk read
+    std::atomic<double> sampleRate{44100.0};
+    std::atomic<juce::uint32> lastPulledAt{0};//ms counter, when the audio thread last took a block
+    std::atomic<bool> reversed{false};
+
+    bool followGrowingSource = false;
+    bool isPrepared = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReadAheadAudioSource)
+};
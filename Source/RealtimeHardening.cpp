@@ -0,0 +1,241 @@
+/*
+  ==============================================================================
+
+    RealtimeHardening.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "RealtimeHardening.h"
+#include <cerrno>
+#include <cstring>
+
+#if JUCE_LINUX
+ #include <malloc.h>
+ #include <pthread.h>
+ #include <sched.h>
+ #include <sys/mman.h>
+#endif
+
+namespace
+{
+    juce::Array<int> parseCores(const juce::String& text)
+    {
+        juce::Array<int> cores;
+
+        for(auto& token : juce::StringArray::fromTokens(text, ",", ""))
+            if(token.trim().containsOnly("0123456789") && token.trim().isNotEmpty())
+                cores.addIfNotAlreadyThere(token.trim().getIntValue());
+
+        return cores;
+    }
+
+    constexpr int stackToPrefault = 256 * 1024;
+    constexpr int audioPriorityIfNone = 80;//only used if the device thread isn't realtime already
+}
+
+//==============================================================================
+RealtimeHardening::Options RealtimeHardening::Options::fromEnvironment()
+{
+    Options result;
+    result.enabled = juce::SystemStats::getEnvironmentVariable("MUSICPLAYER_RT", "0").getIntValue() != 0;
+    result.audioCores = parseCores(juce::SystemStats::getEnvironmentVariable("MUSICPLAYER_AUDIO_CORES", {}));
+    result.ioCores = parseCores(juce::SystemStats::getEnvironmentVariable("MUSICPLAYER_IO_CORES", {}));
+    result.ioPriority = juce::SystemStats::getEnvironmentVariable("MUSICPLAYER_IO_PRIORITY", "60").getIntValue();
+    return result;
+}
+
+RealtimeHardening::Options RealtimeHardening::Options::fromArguments(const juce::ArgumentList& args, Options result)
+{
+    if(args.containsOption("--rt"))
+        result.enabled = true;
+
+    if(args.containsOption("--audio-cores"))
+        result.audioCores = parseCores(args.getValueForOption("--audio-cores"));
+
+    if(args.containsOption("--io-cores"))
+        result.ioCores = parseCores(args.getValueForOption("--io-cores"));
+
+    if(args.containsOption("--io-priority"))
+        result.ioPriority = args.getValueForOption("--io-priority").getIntValue();
+
+    return result;
+}
+
+//==============================================================================
+juce::String RealtimeHardening::describeError(int error)
+{
+   #if JUCE_LINUX
+    if(error == EPERM)
+        return "EPERM";
+    if(error == ENOMEM)
+        return "ENOMEM";
+    if(error == EINVAL)
+        return "EINVAL";
+   #endif
+
+    return "error" + juce::String(error);
+}
+
+juce::String RealtimeHardening::describeCores(const juce::Array<int>& cores)
+{
+    juce::StringArray names;
+
+    for(auto core : cores)
+        names.add(juce::String(core));
+
+    return names.joinIntoString("+");
+}
+
+juce::String RealtimeHardening::describePolicy(int policy, int priority)
+{
+   #if JUCE_LINUX
+    if(policy == SCHED_FIFO)
+        return "fifo/" + juce::String(priority);
+    if(policy == SCHED_RR)
+        return "rr/" + juce::String(priority);
+   #endif
+
+    juce::ignoreUnused(policy, priority);
+    return "normal";
+}
+
+int RealtimeHardening::setAffinity(juce::Thread::ThreadID thread, const juce::Array<int>& cores)
+{
+   #if JUCE_LINUX
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    for(auto core : cores)
+        if(core >= 0 && core < CPU_SETSIZE)
+            CPU_SET(core, &set);
+
+    return pthread_setaffinity_np((pthread_t) thread, sizeof(set), &set);
+   #else
+    juce::ignoreUnused(thread, cores);
+    return -1;
+   #endif
+}
+
+//==============================================================================
+void RealtimeHardening::apply(const Options& newOptions)
+{
+    options = newOptions;
+
+    if(! options.enabled)
+        return;
+
+   #if JUCE_LINUX
+    const juce::ScopedLock sl(resultLock);
+
+    if(mlockall(MCL_CURRENT | MCL_FUTURE) == 0){
+
+        //freed blocks stay in the (locked) heap instead of being unmapped and faulted back in
+        mallopt(M_TRIM_THRESHOLD, -1);
+        mallopt(M_MMAP_MAX, 0);
+
+        auto status = juce::File("/proc/self/status").loadFileAsString();
+        auto locked = status.fromFirstOccurrenceOf("VmLck:", false, false).upToFirstOccurrenceOf("\n", false, false).trim();
+        memoryResult = "locked(" + locked.removeCharacters(" ") + ")";
+    }
+    else{
+        memoryResult = "failed(" + describeError(errno) + ",raise-memlock-limit)";
+    }
+   #else
+    memoryResult = "unsupported";
+   #endif
+
+    audioState = pending;
+}
+
+void RealtimeHardening::addIoThread(const juce::String& name, juce::Thread::ThreadID thread)
+{
+    if(! options.enabled)
+        return;
+
+    juce::String result;
+
+   #if JUCE_LINUX
+    sched_param param{};
+    param.sched_priority = juce::jlimit(sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO), options.ioPriority);
+
+    auto error = pthread_setschedparam((pthread_t) thread, SCHED_FIFO, &param);
+    result = error == 0 ? describePolicy(SCHED_FIFO, param.sched_priority) : "normal(" + describeError(error) + ")";
+
+    if(! options.ioCores.isEmpty()){
+        auto affinityError = setAffinity(thread, options.ioCores);
+        result << ",cores=" << (affinityError == 0 ? describeCores(options.ioCores) : "any(" + describeError(affinityError) + ")");
+    }
+   #else
+    juce::ignoreUnused(thread);
+    result = "unsupported";
+   #endif
+
+    const juce::ScopedLock sl(resultLock);
+    ioResults.add(name + "=" + result);
+}
+
+void RealtimeHardening::audioThreadStarted()
+{
+    int expected = pending;
+
+    if(! audioState.compare_exchange_strong(expected, claimed))//whoever gets here first does it
+        return;
+
+    //touch the stack so the first deep call doesn't fault (locked by MCL_FUTURE from here on)
+    volatile char stack[stackToPrefault];
+    std::memset(const_cast<char*>(stack), 0, sizeof(stack));
+
+   #if JUCE_LINUX
+    sched_param param{};
+    pthread_getschedparam(pthread_self(), &audioPolicy, &param);
+    audioPriority = param.sched_priority;
+
+    if(audioPolicy != SCHED_FIFO && audioPolicy != SCHED_RR){
+
+        param.sched_priority = juce::jmin(audioPriorityIfNone, sched_get_priority_max(SCHED_FIFO));
+        audioPriorityError = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+
+        if(audioPriorityError == 0){
+            audioPolicy = SCHED_FIFO;
+            audioPriority = param.sched_priority;
+        }
+    }
+
+    audioAffinityError = options.audioCores.isEmpty() ? 0 : setAffinity((juce::Thread::ThreadID) pthread_self(), options.audioCores);
+   #endif
+
+    audioState.store(done, std::memory_order_release);
+}
+
+juce::String RealtimeHardening::getReport() const
+{
+    if(! options.enabled)
+        return "rt=off";
+
+    juce::String report("rt=on");
+
+    const juce::ScopedLock sl(resultLock);
+    report << " memory=" << memoryResult;
+
+    auto state = audioState.load(std::memory_order_acquire);
+
+    if(state != done){
+        report << " audio=waiting";//no callback yet
+    }
+    else{
+        report << " audio=" << describePolicy(audioPolicy, audioPriority);
+
+        if(audioPriorityError != 0)
+            report << "(" << describeError(audioPriorityError) << ")";
+
+        if(! options.audioCores.isEmpty())
+            report << ",cores=" << (audioAffinityError == 0 ? describeCores(options.audioCores) : "any(" + describeError(audioAffinityError) + ")");
+    }
+
+    for(auto& result : ioResults)
+        report << " " << result;
+
+    return report;
+}
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    RealtimeHardening.h
+    Created: 19 Oct 2026
+
+    Opt-in measures against page faults and preemption on busy playout machines,
+    for the Standalone and headless builds only (never inside someone's DAW).
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+//==============================================================================
+/**
+    When enabled this:
+
+      - locks all current and future memory (mlockall), so the transport, the
+        read-ahead rings and the pre-decoded buffers can't be paged out, and stops
+        malloc handing freed memory back so it doesn't fault in again later
+      - pre-faults a stack's worth of memory on the audio thread
+      - moves the StreamScheduler I/O threads and the preload thread to SCHED_FIFO, where the
+        process is allowed to
+      - pins the audio thread and those I/O threads to the given cores
+
+    Every one of those can be refused by the system (RLIMIT_MEMLOCK, RLIMIT_RTPRIO,
+    a cpuset), so each records what actually happened and getReport() says so.
+
+    The Standalone reads its options from the environment:
+
+        MUSICPLAYER_RT=1  MUSICPLAYER_AUDIO_CORES=2,3  MUSICPLAYER_IO_CORES=1
+        MUSICPLAYER_IO_PRIORITY=60
+
+    and the headless daemon also takes --rt, --audio-cores=, --io-cores= and
+    --io-priority=.
+*/
+class RealtimeHardening
+{
+public:
+    struct Options
+    {
+        bool enabled = false;
+        juce::Array<int> audioCores;//empty: leave the affinity alone
+        juce::Array<int> ioCores;
+        int ioPriority = 60;//SCHED_FIFO, below the audio device's own thread
+
+        static Options fromEnvironment();
+        static Options fromArguments (const juce::ArgumentList& args, Options defaults);
+    };
+
+    RealtimeHardening() = default;
+
+    /** Message thread, once. Locks memory; the threads follow as they register. */
+    void apply (const Options& newOptions);
+
+    bool isEnabled() const noexcept             { return options.enabled; }
+
+    /** Any thread: priority and affinity for a decode or I/O thread. */
+    void addIoThread (const juce::String& name, juce::Thread::ThreadID thread);
+
+    /** Audio thread: processBlock checks this every callback, it's one atomic load. */
+    bool isAudioThreadPending() const noexcept  { return audioState.load (std::memory_order_relaxed) == pending; }
+
+    /** Audio thread, once: the first callback after apply() sets it up. Makes system calls. */
+    void audioThreadStarted();
+
+    /** One line of key=value pairs describing what took effect. */
+    juce::String getReport() const;
+
+private:
+    enum AudioState { notRequested, pending, claimed, done };
+
+    static juce::String describeError (int error);
+    static juce::String describeCores (const juce::Array<int>& cores);
+    static juce::String describePolicy (int policy, int priority);
+    static int setAffinity (juce::Thread::ThreadID thread, const juce::Array<int>& cores);//0 or errno
+
+    Options options;
+
+    juce::String memoryResult{"off"};
+    juce::StringArray ioResults;//"name=..." for each thread
+    juce::CriticalSection resultLock;
+
+    //written once by the audio thread, read after audioState says it's done
+    std::atomic<int> audioState{notRequested};
+    int audioPolicy = 0, audioPriority = 0;
+    int audioPriorityError = 0, audioAffinityError = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RealtimeHardening)
+};
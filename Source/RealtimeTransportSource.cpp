@@ -0,0 +1,344 @@
+/*
+  ==============================================================================
+
+    RealtimeTransportSource.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "RealtimeTransportSource.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+RealtimeTransportSource::RealtimeTransportSource(double maximumSpeed, std::function<void()> seekCallback)
+    : maxSpeed(maximumSpeed), onSeek(std::move(seekCallback))
+{
+    startTimerHz(100);
+}
+
+RealtimeTransportSource::~RealtimeTransportSource()
+{
+    stopTimer();
+    setSource(nullptr, 0.0);
+}
+
+void RealtimeTransportSource::setSource(juce::PositionableAudioSource* newSource, double newSourceSampleRate)
+{
+    juce::PositionableAudioSource* oldSource;
+
+    //the audio thread lets go of the old source first, so nothing below races with a block
+    {
+        const juce::SpinLock::ScopedLockType sl(sourceLock);
+        oldSource = source;
+        source = nullptr;
+        playing = false;
+        stopped = true;
+        inputStreamEOF = false;
+        pendingPosition = -1;//a new source starts at its start
+    }
+
+    if(oldSource != nullptr)
+        oldSource->releaseResources();
+
+    if(newSource == nullptr)
+        return;
+
+    sourceSampleRate = newSourceSampleRate;
+
+    if(isPrepared){
+        auto inputBlockSize = getInputBlockSize(getSourceRate());
+        newSource->prepareToPlay(inputBlockSize, getSourceRate());
+        inputBuffer.setSize(maxChannels, inputBlockSize);
+    }
+
+    attachSource(newSource);
+}
+
+void RealtimeTransportSource::start()
+{
+    if(playing.load() || source == nullptr)
+        return;
+
+    inputStreamEOF = false;
+    stopped = false;
+    playing = true;
+    stopPending = false;
+    sendChangeMessage();
+}
+
+void RealtimeTransportSource::stop()
+{
+    if(! playing.exchange(false))
+        return;
+
+    stopPending = true;
+    stopRequestedAt = juce::Time::getMillisecondCounter();
+}
+
+void RealtimeTransportSource::timerCallback()
+{
+    if(seekMade.exchange(false) && onSeek != nullptr)
+        onSeek();
+
+    if(finishedPending.exchange(false))
+        sendChangeMessage();
+
+    if(stopPending && (stopped.load() || juce::Time::getMillisecondCounter() - stopRequestedAt > stopTimeoutMs)){
+        stopPending = false;
+        sendChangeMessage();
+    }
+}
+
+void RealtimeTransportSource::setPosition(double seconds)
+{
+    setNextReadPosition((juce::int64) (seconds * sampleRate));
+}
+
+double RealtimeTransportSource::getCurrentPosition() const
+{
+    return (double) getNextReadPosition() / sampleRate;
+}
+
+double RealtimeTransportSource::getLengthInSeconds() const
+{
+    return (double) getTotalLength() / sampleRate;
+}
+
+int RealtimeTransportSource::getInputBlockSize(double rate) const
+{
+    //the most a block of blockSize can need at maxSpeed, plus the interpolator's rounding
+    return (int) std::ceil(blockSize * maxSpeed * rate / sampleRate) + 4;
+}
+
+//==============================================================================
+juce::PositionableAudioSource* RealtimeTransportSource::detachSource()
+{
+    const juce::SpinLock::ScopedLockType sl(sourceLock);
+    auto* detached = source;
+    source = nullptr;
+    return detached;
+}
+
+void RealtimeTransportSource::attachSource(juce::PositionableAudioSource* newSource)
+{
+    const juce::SpinLock::ScopedLockType sl(sourceLock);
+    source = newSource;
+    flush();
+}
+
+void RealtimeTransportSource::prepareToPlay(int samplesPerBlockExpected, double newSampleRate)
+{
+    //preparing a read-ahead waits for it to fill, so the audio thread sees no source meanwhile
+    auto* current = detachSource();
+
+    sampleRate = newSampleRate;
+    blockSize = samplesPerBlockExpected;
+    isPrepared = true;
+
+    auto inputBlockSize = getInputBlockSize(getSourceRate());
+    inputBuffer.setSize(maxChannels, inputBlockSize);
+
+    if(current != nullptr)
+        current->prepareToPlay(inputBlockSize, getSourceRate());
+
+    attachSource(current);
+}
+
+void RealtimeTransportSource::releaseResources()
+{
+    auto* current = detachSource();
+    isPrepared = false;
+
+    if(current != nullptr)
+        current->releaseResources();
+
+    attachSource(current);
+}
+
+void RealtimeTransportSource::flush()
+{
+    numBuffered = 0;
+
+    for(auto& interpolator : interpolators)
+        interpolator.reset();
+}
+
+void RealtimeTransportSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& info)
+{
+    renderBlock(*info.buffer, info.startSample, info.numSamples);
+}
+
+template <typename FloatType>
+void RealtimeTransportSource::renderBlock(juce::AudioBuffer<FloatType>& buffer, int startSample, int numSamples)
+{
+    const juce::SpinLock::ScopedLockType sl(sourceLock);
+    auto newGain = gain.load();
+
+    //seeks first, stopped or not, so a parked read-ahead refills from the new position
+    if(source != nullptr && isPrepared){
+
+        auto seekTo = pendingPosition.exchange(-1);
+
+        if(seekTo >= 0){
+            source->setNextReadPosition((juce::int64) ((double) seekTo * getSourceRate() / sampleRate));
+            flush();
+            seekMade = true;
+        }
+    }
+
+    if(source == nullptr || ! isPrepared || stopped.load()){
+        buffer.clear(startSample, numSamples);
+        lastGain = newGain;
+        return;
+    }
+
+    bool fadingOut = ! playing.load();
+
+    render(buffer, startSample, numSamples);
+
+    if(fadingOut){
+        //just stopped: this block is the last, faded out like AudioTransportSource's
+        for(int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            buffer.applyGainRamp(channel, startSample, juce::jmin(fadeOutSamples, numSamples), (FloatType) 1, (FloatType) 0);
+
+        if(numSamples > fadeOutSamples)
+            buffer.clear(startSample + fadeOutSamples, numSamples - fadeOutSamples);
+    }
+
+    //a reversed source stops at 0 and plays silence there, so that's its end. nothing loops backwards
+    auto finished = backwards.load() ? source->getNextReadPosition() <= 0
+                                     : ! source->isLooping() && source->getNextReadPosition() > source->getTotalLength() + 1;
+
+    if(finished){
+        playing = false;
+        inputStreamEOF = true;
+        finishedPending = true;
+    }
+
+    stopped = ! playing.load();
+
+    for(int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        buffer.applyGainRamp(channel, startSample, numSamples, (FloatType) lastGain, (FloatType) newGain);
+
+    lastGain = newGain;
+}
+
+template <typename FloatType>
+void RealtimeTransportSource::render(juce::AudioBuffer<FloatType>& buffer, int startSample, int numSamples)
+{
+    auto ratio = speed * getSourceRate() / sampleRate;
+    auto numChannels = juce::jmin(buffer.getNumChannels(), maxChannels);
+
+    for(int channel = numChannels; channel < buffer.getNumChannels(); ++channel)
+        buffer.clear(channel, startSample, numSamples);
+
+    //always through the interpolators, even at a ratio of 1 where they only delay by a few samples:
+    //switching them in and out would restart them from silence, a click every time RATE left 1.
+    //in chunks of the prepared block size, which is what inputBuffer is sized for
+    for(int done = 0; done < numSamples;){
+
+        auto numThisTime = juce::jmin(numSamples - done, blockSize);
+        auto needed = juce::jmin((int) std::ceil(numThisTime * ratio) + 2, inputBuffer.getNumSamples());
+
+        if(needed > numBuffered){
+            source->getNextAudioBlock(juce::AudioSourceChannelInfo(&inputBuffer, numBuffered, needed - numBuffered));
+            numBuffered = needed;
+        }
+
+        int used = 0;
+
+        for(int channel = 0; channel < numChannels; ++channel)
+            used = interpolators[(size_t) channel].process(ratio, inputBuffer.getReadPointer(channel),
+                                                           buffer.getWritePointer(channel, startSample + done), numThisTime);
+
+        consumeInput(juce::jmin(used, numBuffered));
+        done += numThisTime;
+    }
+}
+
+void RealtimeTransportSource::consumeInput(int numSamples)
+{
+    numBuffered -= numSamples;
+
+    if(numBuffered > 0 && numSamples > 0)
+        for(int channel = 0; channel < inputBuffer.getNumChannels(); ++channel){
+            auto* samples = inputBuffer.getWritePointer(channel);
+            std::memmove(samples, samples + numSamples, (size_t) numBuffered * sizeof(float));
+        }
+}
+
+//==============================================================================
+void RealtimeTransportSource::Interpolator::reset() noexcept
+{
+    std::fill(std::begin(history), std::end(history), 0.0f);
+    position = 1.0;
+}
+
+template <typename FloatType>
+int RealtimeTransportSource::Interpolator::process(double ratio, const float* input, FloatType* output, int numOutputSamples) noexcept
+{
+    auto pos = position;
+    int used = 0;
+
+    for(int i = 0; i < numOutputSamples; ++i){
+
+        while(pos >= 1.0){
+            history[0] = history[1];
+            history[1] = history[2];
+            history[2] = history[3];
+            history[3] = input[used++];
+            pos -= 1.0;
+        }
+
+        //the cubic through history at -1, 0, 1 and 2, at t
+        auto t = (FloatType) pos;
+        auto y0 = (FloatType) history[0], y1 = (FloatType) history[1], y2 = (FloatType) history[2], y3 = (FloatType) history[3];
+        auto tp1 = t + 1, tm1 = t - 1, tm2 = t - 2;
+
+        output[i] = - y0 * t * tm1 * tm2 / 6
+                    + y1 * tp1 * tm1 * tm2 / 2
+                    - y2 * tp1 * t * tm2 / 2
+                    + y3 * tp1 * t * tm1 / 6;
+
+        pos += ratio;
+    }
+
+    position = pos;
+    return used;
+}
+
+//==============================================================================
+void RealtimeTransportSource::setNextReadPosition(juce::int64 newPosition)
+{
+    //never the source's seek from here, see the class comment
+    pendingPosition = juce::jmax((juce::int64) 0, newPosition);
+}
+
+juce::int64 RealtimeTransportSource::getNextReadPosition() const
+{
+    auto pending = pendingPosition.load();
+
+    if(pending >= 0)
+        return pending;
+
+    const juce::SpinLock::ScopedLockType sl(sourceLock);
+    return source != nullptr ? (juce::int64) ((double) source->getNextReadPosition() * sampleRate / getSourceRate()) : 0;
+}
+
+juce::int64 RealtimeTransportSource::getTotalLength() const
+{
+    const juce::SpinLock::ScopedLockType sl(sourceLock);
+    return source != nullptr ? (juce::int64) ((double) source->getTotalLength() * sampleRate / getSourceRate()) : 0;
+}
+
+bool RealtimeTransportSource::isLooping() const
+{
+    const juce::SpinLock::ScopedLockType sl(sourceLock);
+    return source != nullptr && source->isLooping();
+}
+
+template void RealtimeTransportSource::renderBlock<float>(juce::AudioBuffer<float>&, int, int);
+template void RealtimeTransportSource::renderBlock<double>(juce::AudioBuffer<double>&, int, int);
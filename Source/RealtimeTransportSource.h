@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+    RealtimeTransportSource.h
+    Created: 19 Oct 2026
+
+    Play, stop, seek and gain in front of the playlist, and the one resampling
+    stage: the file's rate to the device's, times the playback speed.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <functional>
+
+//==============================================================================
+/**
+    juce::AudioTransportSource's controls without its lock. AudioTransportSource
+    takes a CriticalSection on every block and sends its change messages from the
+    audio thread, and the ResamplingAudioSource behind it locks as well.
+
+    Here the source, the interpolators and the input buffer are guarded by a
+    SpinLock, like PlaylistAudioSource's tracks. Other threads only hold it for a
+    pointer swap: sources are prepared and released with the lock free and the
+    audio thread seeing no source. Seeks are only stored, and the audio thread
+    makes them at the top of its next block, because a source's seek can reach
+    the StreamScheduler's lock, which nothing may wait on while the audio thread
+    could be spinning on ours. Play state is atomic, and the audio thread only
+    raises flags for a seek made, the stream finishing or a stop having faded
+    out. A timer acts on those: change messages, and onSeek to wake whatever
+    fills the source.
+
+    stop() returns at once. Its change message follows when the audio thread has
+    faded the last block out, or after stopTimeoutMs if nothing is pulling audio.
+
+    Positions are in device samples at normal speed, as with AudioTransportSource,
+    so seconds are the same whatever the playback speed.
+
+    The sources are read as float, as AudioSource only has float blocks; from the
+    interpolators on, everything is in the output's precision, so a double host
+    gets no float copy of its block.
+*/
+class RealtimeTransportSource  : public juce::PositionableAudioSource,
+                                 public juce::ChangeBroadcaster,
+                                 private juce::Timer
+{
+public:
+    /** onSeek is called on the message thread, with no lock held, once a seek has
+        been made, e.g. to wake the threads that refill the source. May be empty. */
+    RealtimeTransportSource (double maxSpeed, std::function<void()> onSeek);
+    ~RealtimeTransportSource() override;
+
+    /** Message thread. Stops playback; the old source is released and the new one
+        prepared (if we are) before the audio thread sees it. sourceSampleRate 0
+        means the device's rate. */
+    void setSource (juce::PositionableAudioSource* newSource, double sourceSampleRate = 0.0);
+
+    /** Message thread. */
+    void start();
+    void stop();
+    bool isPlaying() const noexcept                 { return playing.load(); }
+    /** From the audio thread playing off the end until start() or setSource(); a seek
+        doesn't clear it, so a host relocating after the end can still tell it happened. */
+    bool hasStreamFinished() const noexcept         { return inputStreamEOF.load(); }
+
+    /** Any thread. Made at the start of the next block, reported straight away. */
+    void setPosition (double seconds);
+    double getCurrentPosition() const;
+    double getLengthInSeconds() const;
+
+    /** Any thread, ramped over the next block. */
+    void setGain (float newGain) noexcept           { gain = newGain; }
+    float getGain() const noexcept                  { return gain.load(); }
+
+    /** Audio thread, before getNextAudioBlock. Limited to the maxSpeed we were made with. */
+    void setSpeed (double newSpeed) noexcept        { speed = juce::jlimit(0.0, maxSpeed, newSpeed); }
+
+    /** Audio thread, before getNextAudioBlock. The source is playing towards its start
+        (it turns itself round), so its stream ends at 0 rather than past its length. */
+    void setPlayingBackwards (bool shouldBeBackwards) noexcept  { backwards = shouldBeBackwards; }
+    bool isPlayingBackwards() const noexcept        { return backwards.load(); }
+
+    //==============================================================================
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock (const juce::AudioSourceChannelInfo& info) override;
+
+    /** Audio thread. getNextAudioBlock for float or double buffers. */
+    template <typename FloatType>
+    void renderBlock (juce::AudioBuffer<FloatType>& buffer, int startSample, int numSamples);
+
+    void setNextReadPosition (juce::int64 newPosition) override;
+    juce::int64 getNextReadPosition() const override;
+    juce::int64 getTotalLength() const override;
+    bool isLooping() const override;
+
+    static constexpr int maxChannels = 2;
+    static constexpr int fadeOutSamples = 256;
+    static constexpr juce::uint32 stopTimeoutMs = 100;
+
+private:
+    /** 4-point Lagrange, reading float and writing FloatType. juce::LagrangeInterpolator
+        only writes float. Same use: process() returns the input samples consumed,
+        and starts again from silence after reset(). */
+    struct Interpolator
+    {
+        void reset() noexcept;
+
+        template <typename FloatType>
+        int process (double ratio, const float* input, FloatType* output, int numOutputSamples) noexcept;
+
+        float history[4] = {};//oldest first, output lies between [1] and [2]
+        double position = 1.0;
+    };
+
+    void timerCallback() override;
+
+    juce::PositionableAudioSource* detachSource();
+    void attachSource (juce::PositionableAudioSource* newSource);
+    template <typename FloatType>
+    void render (juce::AudioBuffer<FloatType>& buffer, int startSample, int numSamples);
+    void consumeInput (int numSamples);
+    void flush();
+    int getInputBlockSize (double rate) const;
+    double getSourceRate() const            { return sourceSampleRate > 0.0 ? sourceSampleRate : sampleRate; }
+
+    const double maxSpeed;
+    const std::function<void()> onSeek;
+
+    mutable juce::SpinLock sourceLock;//the audio thread renders under this
+    juce::PositionableAudioSource* source = nullptr;
+    double sourceSampleRate = 0.0;
+    double sampleRate = 44100.0;
+    int blockSize = 0;
+    bool isPrepared = false;
+
+    //source samples read but not interpolated yet, at most a few
+    juce::AudioBuffer<float> inputBuffer;
+    int numBuffered = 0;
+    std::array<Interpolator, maxChannels> interpolators;
+    double speed = 1.0;//audio thread
+    std::atomic<bool> backwards{false};
+
+    std::atomic<juce::int64> pendingPosition{-1};//device samples, -1 for none
+    std::atomic<bool> seekMade{false};
+
+    std::atomic<bool> playing{false};
+    std::atomic<bool> stopped{true};//the audio thread has faded out
+    std::atomic<bool> inputStreamEOF{false};
+    std::atomic<bool> finishedPending{false};//set by the audio thread, the timer sends the change message
+    std::atomic<float> gain{1.0f};
+    float lastGain = 1.0f;
+
+    bool stopPending = false;//message thread
+    juce::uint32 stopRequestedAt = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RealtimeTransportSource)
+};
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    ResidentAudioSource.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ResidentAudioSource.h"
+#include <algorithm>
+
+ResidentAudioSource::ResidentAudioSource(juce::AudioFormatReader& reader, SampleStorage::Format format)
+{
+    auto numSamples = (int) reader.lengthInSamples;
+
+    juce::AudioBuffer<float> decoded(2, numSamples);
+    reader.read(&decoded, 0, numSamples, 0, true, true);
+
+    storage.store(decoded, 0, numSamples, format);
+}
+
+void ResidentAudioSource::getNextAudioBlock(const juce::AudioSourceChannelInfo& info)
+{
+    auto length = (juce::int64) storage.getNumSamples();
+    auto start = position.load();
+    int done = 0;
+
+    if(reversed){
+
+        //the samples just below the position, read in file order then turned round
+        auto blockStart = start - info.numSamples;
+        auto first = juce::jmax((juce::int64) 0, blockStart);
+        auto last = juce::jmin(start, length);
+
+        info.clearActiveBufferRegion();
+
+        if(last > first)
+            storage.read(*info.buffer, info.startSample + (int) (first - blockStart), (int) first, (int) (last - first));
+
+        for(int channel = 0; channel < info.buffer->getNumChannels(); ++channel){
+            auto* samples = info.buffer->getWritePointer(channel, info.startSample);
+            std::reverse(samples, samples + info.numSamples);
+        }
+
+        position = juce::jmax((juce::int64) 0, start - info.numSamples);
+        return;
+    }
+
+    while(done < info.numSamples){
+
+        if(looping && length > 0)
+            start %= length;
+
+        auto numThisTime = (int) juce::jlimit((juce::int64) 0, (juce::int64) (info.numSamples - done), length - start);
+
+        if(numThisTime == 0){
+            info.buffer->clear(info.startSample + done, info.numSamples - done);//past the end
+            start += info.numSamples - done;
+            break;
+        }
+
+        storage.read(*info.buffer, info.startSample + done, (int) start, numThisTime);
+
+        start += numThisTime;
+        done += numThisTime;
+    }
+
+    position = start;
+}
+
+void ResidentAudioSource::setNextReadPosition(juce::int64 newPosition)
+{
+    position = newPosition;
+}
+
+juce::int64 ResidentAudioSource::getNextReadPosition() const
+{
+    return position.load();
+}
+
+juce::int64 ResidentAudioSource::getTotalLength() const
+{
+    return storage.getNumSamples();
+}
+
+bool ResidentAudioSource::isLooping() const
+{
+    return looping.load();
+}
+
+void ResidentAudioSource::setLooping(bool shouldLoop)
+{
+    looping = shouldLoop;
+}
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    ResidentAudioSource.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SampleStorage.h"
+#include <atomic>
+
+//==============================================================================
+/**
+    A whole (short) file decoded into memory and played from there, in whichever
+    SampleStorage format it was given. Stands in for the reader and read-ahead
+    buffer, so jingles and stings kept resident start and seek instantly and,
+    stored compactly, don't cost float's worth of RAM each.
+
+    Reversed, it plays from the position downwards (and doesn't loop).
+*/
+class ResidentAudioSource  : public juce::PositionableAudioSource
+{
+public:
+    /** Decodes all of the reader, into two channels like AudioFormatReaderSource.
+        Not for the audio thread. */
+    ResidentAudioSource (juce::AudioFormatReader& reader, SampleStorage::Format format);
+
+    size_t getSizeInBytes() const               { return storage.getSizeInBytes(); }
+
+    void setReverse (bool shouldReverse)        { reversed = shouldReverse; }
+
+    //==============================================================================
+    void prepareToPlay (int, double) override   {}
+    void releaseResources() override            {}
+    void getNextAudioBlock (const juce::AudioSourceChannelInfo& info) override;
+
+    void setNextReadPosition (juce::int64 newPosition) override;
+    juce::int64 getNextReadPosition() const override;
+    juce::int64 getTotalLength() const override;
+    bool isLooping() const override;
+    void setLooping (bool shouldLoop) override;
+
+private:
+    SampleStorage storage;
+    std::atomic<juce::int64> position{0};
+    std::atomic<bool> looping{false};
+    std::atomic<bool> reversed{false};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResidentAudioSource)
+};
@@ -0,0 +1,423 @@
+/*
+  ==============================================================================
+
+    SampleStorage.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "SampleStorage.h"
+#include <cmath>
+#include <cstring>
+
+#if JUCE_USE_SSE_INTRINSICS
+ #include <emmintrin.h>
+#elif JUCE_USE_ARM_NEON
+ #include <arm_neon.h>
+#endif
+
+namespace
+{
+    juce::uint32 floatBits(float value)     { juce::uint32 bits; std::memcpy(&bits, &value, 4); return bits; }
+    float bitsToFloat(juce::uint32 bits)    { float value; std::memcpy(&value, &bits, 4); return value; }
+
+    //round to nearest even, overflow to infinity (see Fabian Giesen's float_to_half_fast3_rtne)
+    juce::uint16 floatToHalf(float value)
+    {
+        const juce::uint32 f32infinity = 255u << 23;
+        const juce::uint32 f16max = (127u + 16u) << 23;
+        const juce::uint32 denormMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+        auto bits = floatBits(value);
+        auto sign = bits & 0x80000000u;
+        bits ^= sign;
+
+        juce::uint32 result;
+
+        if(bits >= f16max){
+            result = bits > f32infinity ? 0x7e00u : 0x7c00u;
+        }
+        else if(bits < (113u << 23)){
+            result = floatBits(bitsToFloat(bits) + bitsToFloat(denormMagic)) - denormMagic;
+        }
+        else{
+            auto mantissaOdd = (bits >> 13) & 1u;
+            bits += ((juce::uint32) (15 - 127) << 23) + 0xfffu;
+            bits += mantissaOdd;
+            result = bits >> 13;
+        }
+
+        return (juce::uint16) (result | (sign >> 16));
+    }
+
+    float halfToFloat(juce::uint16 half)
+    {
+        const float magic = bitsToFloat((254u - 15u) << 23);
+
+        juce::uint32 exponentAndMantissa = half & 0x7fffu;
+        auto value = bitsToFloat(exponentAndMantissa << 13) * magic;
+        auto bits = floatBits(value);
+
+        if(exponentAndMantissa >= 0x7c00u)
+            bits |= 255u << 23;//inf and nan stay that way
+
+        return bitsToFloat(bits | ((juce::uint32) (half & 0x8000u) << 16));
+    }
+
+    juce::int16 floatToInt16(float value)
+    {
+        return (juce::int16) juce::roundToInt(juce::jlimit(-1.0f, 1.0f, value) * 32767.0f);
+    }
+
+    //==============================================================================
+    void expandInt16(const juce::int16* source, float* dest, int num)
+    {
+        const float scale = 1.0f / 32767.0f;
+        int i = 0;
+
+       #if JUCE_USE_SSE_INTRINSICS
+        const __m128 scaleVector = _mm_set1_ps(scale);
+
+        for(; i + 8 <= num; i += 8){
+            auto raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+            auto low = _mm_srai_epi32(_mm_unpacklo_epi16(raw, raw), 16);//sign extends
+            auto high = _mm_srai_epi32(_mm_unpackhi_epi16(raw, raw), 16);
+            _mm_storeu_ps(dest + i, _mm_mul_ps(_mm_cvtepi32_ps(low), scaleVector));
+            _mm_storeu_ps(dest + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scaleVector));
+        }
+       #elif JUCE_USE_ARM_NEON
+        for(; i + 4 <= num; i += 4){
+            auto widened = vmovl_s16(vld1_s16(source + i));
+            vst1q_f32(dest + i, vmulq_n_f32(vcvtq_f32_s32(widened), scale));
+        }
+       #endif
+
+        for(; i < num; ++i)
+            dest[i] = source[i] * scale;
+    }
+
+    void expandHalf(const juce::uint16* source, float* dest, int num)
+    {
+        int i = 0;
+
+       #if JUCE_USE_SSE_INTRINSICS
+        //the same magic multiply as halfToFloat, which also gets denormals right
+        const __m128i noSign = _mm_set1_epi32(0x7fff);
+        const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+        const __m128i wasInfOrNan = _mm_set1_epi32(0x7bff);
+        const __m128 infOrNanExponent = _mm_castsi128_ps(_mm_set1_epi32(255 << 23));
+
+        for(; i + 4 <= num; i += 4){
+            auto halves = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + i)), _mm_setzero_si128());
+            auto exponentAndMantissa = _mm_and_si128(noSign, halves);
+            auto sign = _mm_slli_epi32(_mm_xor_si128(halves, exponentAndMantissa), 16);
+            auto scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(exponentAndMantissa, 13)), magic);
+            auto infOrNan = _mm_and_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(exponentAndMantissa, wasInfOrNan)), infOrNanExponent);
+            _mm_storeu_ps(dest + i, _mm_or_ps(scaled, _mm_or_ps(_mm_castsi128_ps(sign), infOrNan)));
+        }
+       #elif JUCE_USE_ARM_NEON && defined (__aarch64__)
+        for(; i + 4 <= num; i += 4)
+            vst1q_f32(dest + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(source + i))));
+       #endif
+
+        for(; i < num; ++i)
+            dest[i] = halfToFloat(source[i]);
+    }
+
+    //==============================================================================
+    juce::uint32 zigzag(int value)              { return ((juce::uint32) value << 1) ^ (juce::uint32) (value >> 31); }
+    int unzigzag(juce::uint32 value)            { return (int) (value >> 1) ^ -(int) (value & 1); }
+
+    int residual(const juce::int16* samples, int i, int order)
+    {
+        switch(order){
+            case 0:  return samples[i];
+            case 1:  return samples[i] - samples[i - 1];
+            default: return samples[i] - 2 * samples[i - 1] + samples[i - 2];
+        }
+    }
+
+    int bitsNeeded(juce::uint32 value)
+    {
+        int bits = 0;
+
+        while(value != 0){
+            ++bits;
+            value >>= 1;
+        }
+
+        return bits;
+    }
+}
+
+//==============================================================================
+void SampleStorage::store(const juce::AudioBuffer<float>& source, int sourceStart, int num, Format newFormat)
+{
+    format = newFormat;
+    numChannels = source.getNumChannels();
+    numSamples = num;
+
+    floats.clear();
+    shorts.clear();
+    packed.clear();
+    blockOffsets.clear();
+
+    if(format == Format::float32){
+
+        floats.resize((size_t) (numChannels * numSamples));
+
+        for(int channel = 0; channel < numChannels; ++channel)
+            juce::FloatVectorOperations::copy(floats.data() + channel * numSamples, source.getReadPointer(channel, sourceStart), numSamples);
+
+        return;
+    }
+
+    shorts.resize((size_t) (numChannels * numSamples));
+
+    for(int channel = 0; channel < numChannels; ++channel){
+
+        auto* from = source.getReadPointer(channel, sourceStart);
+        auto* to = shorts.data() + channel * numSamples;
+
+        for(int i = 0; i < numSamples; ++i)
+            to[i] = format == Format::half ? floatToHalf(from[i]) : (juce::uint16) floatToInt16(from[i]);
+    }
+
+    if(format == Format::compressed){
+
+        packed.resize((size_t) numChannels);
+        blockOffsets.resize((size_t) numChannels);
+
+        for(int channel = 0; channel < numChannels; ++channel)
+            compressChannel(channel, reinterpret_cast<const juce::int16*>(shorts.data() + channel * numSamples));
+
+        std::vector<juce::uint16>().swap(shorts);//only the packed form is kept
+    }
+}
+
+size_t SampleStorage::getSizeInBytes() const
+{
+    auto bytes = floats.size() * sizeof(float) + shorts.size() * sizeof(juce::uint16);
+
+    for(size_t channel = 0; channel < packed.size(); ++channel)
+        bytes += packed[channel].size() + blockOffsets[channel].size() * sizeof(juce::uint32);
+
+    return bytes;
+}
+
+//==============================================================================
+// A compressed block: the first two samples as they are, then a byte holding the
+// predictor order (bits five and six, bit seven is unused) and the residual width
+// (bottom five, never more than 18 for 16-bit input), then the zigzagged residuals
+// of the rest, that many bits each, least significant first.
+void SampleStorage::compressChannel(int channel, const juce::int16* samples)
+{
+    auto& bytes = packed[(size_t) channel];
+    auto& offsets = blockOffsets[(size_t) channel];
+
+    for(int blockStart = 0; blockStart < numSamples; blockStart += blockSize){
+
+        offsets.push_back((juce::uint32) bytes.size());
+
+        auto* block = samples + blockStart;
+        auto length = juce::jmin(blockSize, numSamples - blockStart);
+
+        for(int i = 0; i < juce::jmin(2, length); ++i){
+            bytes.push_back((juce::uint8) ((juce::uint16) block[i] & 0xff));
+            bytes.push_back((juce::uint8) ((juce::uint16) block[i] >> 8));
+        }
+
+        if(length <= 2)
+            continue;
+
+        int bestOrder = 0, bestWidth = 32;
+
+        for(int order = 0; order <= 2; ++order){
+
+            juce::uint32 all = 0;
+
+            for(int i = 2; i < length; ++i)
+                all |= zigzag(residual(block, i, order));
+
+            auto width = bitsNeeded(all);
+
+            if(width < bestWidth){
+                bestWidth = width;
+                bestOrder = order;
+            }
+        }
+
+        bytes.push_back((juce::uint8) ((bestOrder << 5) | bestWidth));
+
+        juce::uint64 accumulator = 0;
+        int bitsHeld = 0;
+
+        for(int i = 2; i < length; ++i){
+
+            accumulator |= (juce::uint64) zigzag(residual(block, i, bestOrder)) << bitsHeld;
+            bitsHeld += bestWidth;
+
+            while(bitsHeld >= 8){
+                bytes.push_back((juce::uint8) (accumulator & 0xff));
+                accumulator >>= 8;
+                bitsHeld -= 8;
+            }
+        }
+
+        if(bitsHeld > 0)
+            bytes.push_back((juce::uint8) (accumulator & 0xff));
+    }
+}
+
+void SampleStorage::decompressBlock(int channel, int block, juce::int16* dest) const
+{
+    auto* bytes = packed[(size_t) channel].data() + blockOffsets[(size_t) channel][(size_t) block];
+    auto length = juce::jmin(blockSize, numSamples - block * blockSize);
+
+    for(int i = 0; i < juce::jmin(2, length); ++i, bytes += 2)
+        dest[i] = (juce::int16) (bytes[0] | (bytes[1] << 8));
+
+    if(length <= 2)
+        return;
+
+    auto order = *bytes >> 5;
+    auto width = *bytes & 31;
+    ++bytes;
+
+    auto mask = width == 32 ? 0xffffffffu : (1u << width) - 1u;
+    juce::uint64 accumulator = 0;
+    int bitsHeld = 0;
+
+    for(int i = 2; i < length; ++i){
+
+        while(bitsHeld < width){
+            accumulator |= (juce::uint64) *bytes++ << bitsHeld;
+            bitsHeld += 8;
+        }
+
+        auto value = unzigzag((juce::uint32) accumulator & mask);
+        accumulator >>= width;
+        bitsHeld -= width;
+
+        switch(order){
+            case 0:  dest[i] = (juce::int16) value; break;
+            case 1:  dest[i] = (juce::int16) (value + dest[i - 1]); break;
+            default: dest[i] = (juce::int16) (value + 2 * dest[i - 1] - dest[i - 2]); break;
+        }
+    }
+}
+
+//==============================================================================
+void SampleStorage::read(juce::AudioBuffer<float>& dest, int destStart, int sourceStart, int num) const
+{
+    jassert(sourceStart >= 0 && sourceStart + num <= numSamples);
+
+    auto channelsToRead = juce::jmin(dest.getNumChannels(), numChannels);
+
+    for(int channel = 0; channel < channelsToRead; ++channel)
+        readChannel(channel, dest.getWritePointer(channel, destStart), sourceStart, num);
+
+    for(int channel = channelsToRead; channel < dest.getNumChannels(); ++channel)
+        dest.clear(channel, destStart, num);
+}
+
+void SampleStorage::readChannel(int channel, float* dest, int sourceStart, int num) const
+{
+    switch(format){
+
+        case Format::float32:
+            juce::FloatVectorOperations::copy(dest, floats.data() + channel * numSamples + sourceStart, num);
+            break;
+
+        case Format::int16:
+            expandInt16(reinterpret_cast<const juce::int16*>(shorts.data() + channel * numSamples + sourceStart), dest, num);
+            break;
+
+        case Format::half:
+            expandHalf(shorts.data() + channel * numSamples + sourceStart, dest, num);
+            break;
+
+        case Format::compressed:{
+
+            juce::int16 block[blockSize];
+
+            while(num > 0){
+
+                auto blockIndex = sourceStart / blockSize;
+                auto offset = sourceStart - blockIndex * blockSize;
+                auto numThisTime = juce::jmin(num, blockSize - offset);
+
+                decompressBlock(channel, blockIndex, block);
+                expandInt16(block + offset, dest, numThisTime);
+
+                dest += numThisTime;
+                sourceStart += numThisTime;
+                num -= numThisTime;
+            }
+
+            break;
+        }
+    }
+}
+
+//==============================================================================
+juce::String SampleStorage::getFormatName(Format format)
+{
+    switch(format){
+        case Format::float32:    return "float32";
+        case Format::int16:      return "int16";
+        case Format::half:       return "half";
+        case Format::compressed: return "compressed";
+    }
+
+    return {};
+}
+
+juce::String SampleStorage::describeFormats(const juce::AudioBuffer<float>& audio)
+{
+    const int chunk = 512;//about what the audio thread reads at a time
+    juce::AudioBuffer<float> expanded(audio.getNumChannels(), chunk);
+    juce::String report;
+
+    auto floatBytes = (double) audio.getNumChannels() * audio.getNumSamples() * sizeof(float);
+
+    for(auto format : { Format::float32, Format::int16, Format::half, Format::compressed }){
+
+        SampleStorage storage;
+        storage.store(audio, 0, audio.getNumSamples(), format);
+
+        //expand all of it a few times over, and see how far off the worst sample is
+        float maxError = 0.0f;
+        int passes = 0;
+        auto started = juce::Time::getHighResolutionTicks();
+
+        do{
+            for(int start = 0; start < audio.getNumSamples(); start += chunk){
+
+                auto num = juce::jmin(chunk, audio.getNumSamples() - start);
+                storage.read(expanded, 0, start, num);
+
+                if(passes == 0)
+                    for(int channel = 0; channel < audio.getNumChannels(); ++channel)
+                        for(int i = 0; i < num; ++i)
+                            maxError = juce::jmax(maxError, std::abs(expanded.getSample(channel, i) - audio.getSample(channel, start + i)));
+            }
+
+            ++passes;
+        }
+        while(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - started) < 0.05);
+
+        auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - started);
+        auto samplesExpanded = (double) passes * audio.getNumSamples() * audio.getNumChannels();
+
+        report << getFormatName(format)
+               << " bytes=" << (juce::int64) storage.getSizeInBytes()
+               << " ratio=" << juce::String(storage.getSizeInBytes() / juce::jmax(1.0, floatBytes), 3)
+               << " expandNsPerSample=" << juce::String(seconds * 1.0e9 / juce::jmax(1.0, samplesExpanded), 2)
+               << " maxErrorDb=" << juce::String(juce::Decibels::gainToDecibels(maxError, -200.0f), 1)
+               << "; ";
+    }
+
+    return report.trimCharactersAtEnd("; ");
+}
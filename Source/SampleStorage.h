@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    SampleStorage.h
+    Created: 19 Oct 2026
+
+    Decoded audio held in less memory than 32-bit float.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+//==============================================================================
+/**
+    A multichannel block of samples, stored in one of several formats and expanded
+    back to float as it's read:
+
+    - float32: as decoded, 4 bytes a sample
+    - int16: 2 bytes, about 96 dB of dynamic range
+    - half: 2 bytes, 11 bits of mantissa but the full range of levels
+    - compressed: the int16 values, losslessly packed in blocks of blockSize with
+      whichever of three fixed predictors leaves the smallest residuals. Typical
+      music takes 55-75% of int16, quiet or sparse material a lot less.
+
+    int16 and compressed hold full scale and no more: anything past +-1.0 is
+    clipped as it's stored. Decoded MP3 and AAC overshoot a little on loud
+    masters, and float WAVs can go anywhere, so keep those in half or float32
+    if the overs matter. half keeps them.
+
+    Reading never allocates, so it's fine on the audio thread. int16 and half are
+    expanded with SSE2 (or NEON) kernels, four samples at a time. Compressed blocks
+    are unpacked into a small stack buffer first, then use the int16 kernel.
+*/
+class SampleStorage
+{
+public:
+    enum class Format
+    {
+        float32,
+        int16,
+        half,
+        compressed
+    };
+
+    static constexpr int blockSize = 256;//samples per channel in one compressed block
+
+    SampleStorage() = default;
+
+    /** Replaces the contents with numSamples from source, starting at sourceStart. */
+    void store (const juce::AudioBuffer<float>& source, int sourceStart, int numSamples, Format format);
+
+    /** Expands [sourceStart, sourceStart + numSamples) into dest. */
+    void read (juce::AudioBuffer<float>& dest, int destStart, int sourceStart, int numSamples) const;
+
+    Format getFormat() const noexcept           { return format; }
+    int getNumChannels() const noexcept         { return numChannels; }
+    int getNumSamples() const noexcept          { return numSamples; }
+
+    /** What the samples take up, not counting this object. */
+    size_t getSizeInBytes() const;
+
+    static juce::String getFormatName (Format format);
+
+    /** Stores audio in each format in turn and reports size against float, the time
+        taken to expand it and the largest error. For choosing a format, not for the
+        audio thread. */
+    static juce::String describeFormats (const juce::AudioBuffer<float>& audio);
+
+private:
+    void readChannel (int channel, float* dest, int sourceStart, int num) const;
+    void compressChannel (int channel, const juce::int16* samples);
+    void decompressBlock (int channel, int block, juce::int16* dest) const;
+
+    Format format = Format::float32;
+    int numChannels = 0;
+    int numSamples = 0;
+
+    //float32 and half/int16 keep channels one after another, numSamples apart
+    std::vector<float> floats;
+    std::vector<juce::uint16> shorts;
+
+    //compressed: each channel's blocks in one byte stream, with where every block starts
+    std::vector<std::vector<juce::uint8>> packed;
+    std::vector<std::vector<juce::uint32>> blockOffsets;
+};
@@ -0,0 +1,286 @@
+/*
+  ==============================================================================
+
+    ScrubEngine.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "ScrubEngine.h"
+#include <cmath>
+
+ScrubEngine::ScrubEngine(juce::AudioFormatManager& fm, StreamScheduler& s)
+    : formatManager(fm), scheduler(s)
+{
+    for(auto& slot : slots)
+        slot.setSize(2, chunkSize);
+
+    slotChunks.fill(-1);
+
+    //periodic hann: two of them half a grain apart add up to exactly one
+    window.resize((size_t) grainSize);
+
+    for(int i = 0; i < grainSize; ++i)
+        window[(size_t) i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * (float) i / (float) grainSize);
+}
+
+ScrubEngine::~ScrubEngine()
+{
+    scheduler.removeStream(this);
+}
+
+void ScrubEngine::setFile(const juce::File& file)
+{
+    scheduler.removeStream(this);//no chunk may be reading while the reader changes
+
+    reader.reset(formatManager.createReaderFor(file));
+
+    {
+        const juce::SpinLock::ScopedLockType sl(windowLock);
+        slotChunks.fill(-1);
+        fileLength = reader != nullptr ? reader->lengthInSamples : 0;
+        fileSampleRate = reader != nullptr ? reader->sampleRate : 0.0;
+    }
+
+    if(reader != nullptr)
+        scheduler.addStream(this);
+}
+
+void ScrubEngine::begin(double seconds)
+{
+    targetSeconds = seconds;
+    restartPending = true;
+    scrubbing = true;
+    scheduler.wake();
+}
+
+void ScrubEngine::moveTo(double seconds)
+{
+    targetSeconds = seconds;
+    scheduler.wake();
+}
+
+void ScrubEngine::end()
+{
+    scrubbing = false;
+}
+
+void ScrubEngine::prepare(double sampleRate)
+{
+    outputSampleRate = sampleRate;
+    restartPending = true;
+}
+
+//==============================================================================
+template <typename FloatType>
+void ScrubEngine::render(juce::AudioBuffer<FloatType>& buffer)
+{
+    buffer.clear();
+
+    auto rate = fileSampleRate.load();
+
+    if(rate <= 0.0)
+        return;
+
+    auto targetPosition = targetSeconds.load() * rate;
+
+    if(restartPending.exchange(false) || std::abs(targetPosition - playPosition) > jumpSeconds * rate){
+        playPosition = targetPosition;
+        speed = 0.0;
+        samplesUntilNextGrain = 0;
+
+        for(auto& grain : grains)
+            grain.age = grainSize;
+    }
+
+    auto numSamples = buffer.getNumSamples();
+    auto fileSamplesPerOutputSample = rate / outputSampleRate;
+
+    //the speed that closes the gap in chaseSeconds, arrived at over speedSmoothingSeconds
+    auto wantedSpeed = juce::jlimit(-maxSpeed, maxSpeed, (targetPosition - playPosition) / (chaseSeconds * rate));
+    speed += (wantedSpeed - speed) * (1.0 - std::exp(-numSamples / (speedSmoothingSeconds * outputSampleRate)));
+
+    if(std::abs(speed) > 0.01)
+        direction.store(speed < 0.0 ? -1 : 1, std::memory_order_relaxed);
+
+    auto* left = buffer.getWritePointer(0);
+    auto* right = buffer.getNumChannels() > 1 ? buffer.getWritePointer(1) : nullptr;
+    bool missedAny = false;
+
+    const juce::SpinLock::ScopedLockType sl(windowLock);
+
+    for(int i = 0; i < numSamples; ++i){
+
+        if(--samplesUntilNextGrain <= 0){
+
+            auto& grain = grains[grains[0].age >= grainSize ? 0 : 1];
+            grain.position = playPosition;
+            grain.step = speed * fileSamplesPerOutputSample;
+            grain.gain = (float) juce::jmin(1.0, std::abs(speed) / fullLevelSpeed);
+            grain.age = 0;
+
+            samplesUntilNextGrain = grainSize / 2;
+        }
+
+        float sumLeft = 0.0f, sumRight = 0.0f;
+
+        for(auto& grain : grains){
+
+            if(grain.age >= grainSize)
+                continue;
+
+            float sampleLeft, sampleRight;
+
+            if(grain.gain > 0.0f){
+                if(readSample(grain.position + grain.age * grain.step, sampleLeft, sampleRight)){
+                    auto gain = grain.gain * window[(size_t) grain.age];
+                    sumLeft += sampleLeft * gain;
+                    sumRight += sampleRight * gain;
+                }
+                else{
+                    missedAny = true;
+                }
+            }
+
+            ++grain.age;
+        }
+
+        left[i] = (FloatType) sumLeft;
+
+        if(right != nullptr)
+            right[i] = (FloatType) sumRight;
+
+        playPosition += speed * fileSamplesPerOutputSample;
+    }
+
+    if(missedAny)
+        underruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+template void ScrubEngine::render(juce::AudioBuffer<float>&);
+template void ScrubEngine::render(juce::AudioBuffer<double>&);
+
+bool ScrubEngine::readSample(double position, float& left, float& right) const
+{
+    left = right = 0.0f;
+
+    auto index = (juce::int64) std::floor(position);
+
+    if(index < 0 || index + 1 >= fileLength)
+        return true;//off either end of the file is silence, not a miss
+
+    auto fraction = (float) (position - (double) index);
+
+    //the two samples either side, which can straddle a chunk boundary
+    for(int n = 0; n < 2; ++n){
+
+        auto sampleIndex = index + n;
+        auto chunk = sampleIndex / chunkSize;
+        auto slot = (size_t) (chunk % numChunks);
+
+        if(slotChunks[slot] != chunk)
+            return false;
+
+        auto offset = (int) (sampleIndex - chunk * chunkSize);
+        auto weight = n == 0 ? 1.0f - fraction : fraction;
+
+        left += slots[slot].getSample(0, offset) * weight;
+        right += slots[slot].getSample(1, offset) * weight;
+    }
+
+    return true;
+}
+
+//==============================================================================
+juce::int64 ScrubEngine::findMissingChunk() const
+{
+    auto rate = fileSampleRate.load();
+
+    if(rate <= 0.0 || fileLength <= 0)
+        return -1;
+
+    auto lastChunk = (fileLength - 1) / chunkSize;
+    auto centre = juce::jlimit((juce::int64) 0, lastChunk, (juce::int64) (targetSeconds.load() * rate) / chunkSize);
+    auto dir = direction.load(std::memory_order_relaxed);
+    auto first = centre - (dir > 0 ? chunksBehind : numChunks - 1 - chunksBehind);
+
+    //outwards from the centre, ahead before behind
+    for(int distance = 0; distance < numChunks; ++distance){
+        for(auto sign : { dir, -dir }){
+
+            auto chunk = centre + sign * distance;
+
+            if(chunk < first || chunk >= first + numChunks || chunk < 0 || chunk > lastChunk)
+                continue;
+
+            if(slotChunks[(size_t) (chunk % numChunks)] != chunk)
+                return chunk;
+
+            if(distance == 0)
+                break;
+        }
+    }
+
+    return -1;
+}
+
+double ScrubEngine::getSecondsUntilUnderrun() const
+{
+    const juce::SpinLock::ScopedLockType sl(windowLock);
+
+    auto rate = fileSampleRate.load();
+
+    if(rate <= 0.0 || fileLength <= 0)
+        return 0.0;
+
+    //decoded audio in front of the drag position, at the speed it's being crossed
+    auto lastChunk = (fileLength - 1) / chunkSize;
+    auto chunk = (juce::int64) (targetSeconds.load() * rate) / chunkSize;
+    auto dir = direction.load(std::memory_order_relaxed);
+    int numReady = 0;
+
+    for(; numReady < numChunks - chunksBehind && chunk >= 0 && chunk <= lastChunk; ++numReady, chunk += dir)
+        if(slotChunks[(size_t) (chunk % numChunks)] != chunk)
+            break;
+
+    return numReady * chunkSize / rate / maxSpeed;
+}
+
+bool ScrubEngine::hasWorkToDo() const
+{
+    const juce::SpinLock::ScopedLockType sl(windowLock);
+    return findMissingChunk() >= 0;
+}
+
+bool ScrubEngine::readNextChunk()
+{
+    juce::int64 chunk;
+    size_t slot;
+
+    {
+        const juce::SpinLock::ScopedLockType sl(windowLock);
+
+        chunk = findMissingChunk();
+
+        if(chunk < 0 || reader == nullptr)
+            return false;
+
+        slot = (size_t) (chunk % numChunks);
+        slotChunks[slot] = -1;//whatever was there has left the window
+    }
+
+    //outside the lock: the audio thread won't look at a slot marked -1
+    auto start = chunk * chunkSize;
+    auto numSamples = (int) juce::jmin((juce::int64) chunkSize, reader->lengthInSamples - start);
+
+    slots[slot].clear();
+    reader->read(&slots[slot], 0, numSamples, start, true, true);
+
+    {
+        const juce::SpinLock::ScopedLockType sl(windowLock);
+        slotChunks[slot] = chunk;
+    }
+
+    return true;
+}
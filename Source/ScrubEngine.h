@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    ScrubEngine.h
+    Created: 19 Oct 2026
+
+    What you hear while dragging the position slider: short grains at the drag
+    position, faster or backwards as the mouse moves.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "StreamScheduler.h"
+
+//==============================================================================
+/**
+    The audio comes from a window of numChunks decoded chunks around the drag
+    position, filled by the shared StreamScheduler from a reader of its own, never
+    by the audio thread. Chunk n always lives in slot n % numChunks, so any run of
+    numChunks chunks has one slot each and sliding the window only replaces the
+    chunks that fell out of it. The window reaches further ahead in the direction
+    the mouse is moving, and is decoded nearest-first from the drag position.
+
+    On the audio thread a playhead chases the mouse: its speed closes the gap
+    in chaseSeconds, limited to maxSpeed in either direction. Every grainSize / 2
+    samples a Hann-windowed grain starts at the playhead, reading at the speed of
+    the moment, so pitch and direction follow the drag and a mouse held still fades
+    to silence. Anything not decoded yet plays as silence rather than waiting for it.
+*/
+class ScrubEngine  : private StreamScheduler::Stream
+{
+public:
+    static constexpr int chunkSize = 8192;
+    static constexpr int numChunks = 32;//six seconds at 44.1 kHz
+    static constexpr int chunksBehind = 11;//of the window, against the direction of the drag
+    static constexpr int grainSize = 2048;//output samples
+    static constexpr double chaseSeconds = 0.08;
+    static constexpr double speedSmoothingSeconds = 0.02;
+    static constexpr double maxSpeed = 4.0;
+    static constexpr double fullLevelSpeed = 0.25;//grains fade in up to this speed
+    static constexpr double jumpSeconds = 1.0;//a gap this big is a click on the slider: jump, don't chase
+
+    ScrubEngine (juce::AudioFormatManager& formatManager, StreamScheduler& scheduler);
+    ~ScrubEngine() override;
+
+    /** Message thread. Opens its own reader for the file playing now. */
+    void setFile (const juce::File& file);
+
+    /** Message thread. */
+    void begin (double seconds);
+    void moveTo (double seconds);
+    void end();
+
+    bool isScrubbing() const noexcept           { return scrubbing.load(); }
+    double getTargetSeconds() const noexcept    { return targetSeconds.load(); }
+
+    void prepare (double sampleRate);
+
+    /** Audio thread, instead of the transport while isScrubbing(). */
+    template <typename FloatType>
+    void render (juce::AudioBuffer<FloatType>& buffer);
+
+private:
+    struct Grain
+    {
+        double position = 0.0;//in the file, at the grain's first sample
+        double step = 0.0;//file samples per output sample
+        float gain = 0.0f;
+        int age = grainSize;//finished
+    };
+
+    double getSecondsUntilUnderrun() const override;
+    bool isActive() const override              { return scrubbing.load(); }
+    bool hasWorkToDo() const override;
+    bool readNextChunk() override;
+    juce::String getStreamName() const override { return "scrub"; }
+
+    juce::int64 findMissingChunk() const;//nearest first, -1 if the window is complete. under windowLock
+    bool readSample (double position, float& left, float& right) const;//under windowLock
+
+    juce::AudioFormatManager& formatManager;
+    StreamScheduler& scheduler;
+    std::unique_ptr<juce::AudioFormatReader> reader;//only used by readNextChunk, swapped while it can't run
+
+    //slotChunks only changes under windowLock. a slot being decoded into is marked -1 first
+    juce::SpinLock windowLock;
+    std::array<juce::AudioBuffer<float>, numChunks> slots;
+    std::array<juce::int64, numChunks> slotChunks;
+    juce::int64 fileLength = 0;
+    std::atomic<double> fileSampleRate{0.0};
+
+    std::atomic<bool> scrubbing{false};
+    std::atomic<bool> restartPending{false};
+    std::atomic<double> targetSeconds{0.0};
+    std::atomic<int> direction{1};//of the playhead, for which way the window leans
+
+    //audio thread only
+    double outputSampleRate = 44100.0;
+    double playPosition = 0.0;//file samples
+    double speed = 0.0;//1 is normal speed, negative is backwards
+    int samplesUntilNextGrain = 0;
+    std::array<Grain, 2> grains;
+    std::vector<float> window;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ScrubEngine)
+};
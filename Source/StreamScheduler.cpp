@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+    StreamScheduler.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "StreamScheduler.h"
+
+class StreamScheduler::Worker  : public juce::Thread
+{
+public:
+    Worker(StreamScheduler& o, int index)
+        : juce::Thread("MusicPlayer I/O " + juce::String(index)), owner(o) {}
+
+    void run() override
+    {
+        while(! threadShouldExit())
+            if(! owner.serviceNextStream())
+                owner.workAvailable.wait(idleWaitMs);//also picks up seeks made from the audio thread, which can't wake us
+    }
+
+private:
+    StreamScheduler& owner;
+};
+
+//==============================================================================
+StreamScheduler::StreamScheduler()
+{
+    //a couple of threads keep a disk busy, more would only seek it about
+    auto numThreads = juce::jlimit(1, maxThreads, juce::SystemStats::getNumCpus() / 2);
+
+    for(int i = 0; i < numThreads; ++i){
+        auto* worker = workers.add(new Worker(*this, i + 1));
+        worker->startThread(3);//as the per-processor read-ahead thread used to be
+    }
+}
+
+StreamScheduler::~StreamScheduler()
+{
+    for(auto* worker : workers)
+        worker->signalThreadShouldExit();
+
+    workAvailable.signal();
+
+    for(auto* worker : workers)
+        worker->stopThread(1000);
+
+    jassert(streams.isEmpty());//every stream should have removed itself by now
+}
+
+//==============================================================================
+void StreamScheduler::addStream(Stream* stream)
+{
+    {
+        const juce::ScopedLock sl(lock);
+        streams.addIfNotAlreadyThere(stream);
+    }
+
+    wake();
+}
+
+void StreamScheduler::removeStream(Stream* stream)
+{
+    const juce::ScopedLock sl(lock);
+
+    if(! streams.contains(stream))
+        return;
+
+    streams.removeFirstMatchingValue(stream);//no worker can pick it from here on
+
+    while(stream->busy){
+        chunkFinished.reset();
+        const juce::ScopedUnlock su(lock);
+        chunkFinished.wait(5);
+    }
+
+    retiredChunks += stream->chunksRead;
+    retiredUnderruns += stream->underruns.load();
+}
+
+void StreamScheduler::wake()
+{
+    workAvailable.signal();
+}
+
+//==============================================================================
+bool StreamScheduler::serviceNextStream()
+{
+    Stream* chosen = nullptr;
+    double lead = 0.0;
+
+    {
+        const juce::ScopedLock sl(lock);
+        double earliest = 0.0;
+
+        for(auto* stream : streams){
+
+            if(stream->busy || ! stream->hasWorkToDo())
+                continue;
+
+            auto secondsLeft = stream->getSecondsUntilUnderrun();
+            auto deadline = secondsLeft + (stream->isActive() ? 0.0 : idleHandicapSeconds);
+
+            if(chosen == nullptr || deadline < earliest){
+                chosen = stream;
+                earliest = deadline;
+                lead = secondsLeft;
+            }
+        }
+
+        if(chosen == nullptr)
+            return false;
+
+        chosen->busy = true;
+
+        if(chosen->isActive() && (chosen->worstLeadSeconds < 0.0 || lead < chosen->worstLeadSeconds))
+            chosen->worstLeadSeconds = lead;
+    }
+
+    auto didRead = chosen->readNextChunk();
+
+    {
+        const juce::ScopedLock sl(lock);
+        chosen->busy = false;
+
+        if(didRead)
+            ++chosen->chunksRead;
+    }
+
+    chunkFinished.signal();
+    return didRead;
+}
+
+bool StreamScheduler::anyStreamIsUrgent() const
+{
+    const juce::ScopedLock sl(lock);
+
+    for(auto* stream : streams)
+        if(stream->isActive() && stream->hasWorkToDo() && stream->getSecondsUntilUnderrun() < urgentSeconds)
+            return true;
+
+    return false;
+}
+
+void StreamScheduler::waitWhileStreamsAreUrgent(int maxMilliseconds)
+{
+    auto giveUpAt = juce::Time::getMillisecondCounter() + (juce::uint32) juce::jmax(0, maxMilliseconds);
+
+    if(! anyStreamIsUrgent())
+        return;
+
+    ++backgroundWaits;
+    wake();
+
+    while(anyStreamIsUrgent() && juce::Time::getMillisecondCounter() < giveUpAt)
+        juce::Thread::sleep(idleWaitMs);
+}
+
+//==============================================================================
+juce::Array<juce::Thread::ThreadID> StreamScheduler::getThreadIds() const
+{
+    juce::Array<juce::Thread::ThreadID> ids;
+
+    for(auto* worker : workers)
+        ids.add(worker->getThreadId());
+
+    return ids;
+}
+
+juce::String StreamScheduler::getReport() const
+{
+    const juce::ScopedLock sl(lock);
+
+    auto chunks = retiredChunks;
+    auto underruns = retiredUnderruns;
+
+    for(auto* stream : streams){
+        chunks += stream->chunksRead;
+        underruns += stream->underruns.load();
+    }
+
+    juce::String report;
+    report << "threads=" << workers.size() << " streams=" << streams.size() << " chunks=" << chunks
+           << " underruns=" << underruns << " backgroundWaits=" << backgroundWaits.load();
+
+    for(auto* stream : streams){
+        report << " | " << stream->getStreamName().quoted()
+               << (stream->isActive() ? " playing" : " idle")
+               << " lead=" << juce::String(stream->getSecondsUntilUnderrun(), 3)
+               << " worstLead=" << juce::String(stream->worstLeadSeconds, 3)
+               << " chunks=" << stream->chunksRead
+               << " underruns=" << stream->underruns.load();
+    }
+
+    return report;
+}
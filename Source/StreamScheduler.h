@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    StreamScheduler.h
+    Created: 19 Oct 2026
+
+    One pool of disk/decode threads for every stream in the process, shared by
+    all MusicPlayerAudioProcessor instances through a SharedResourcePointer.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+//==============================================================================
+/**
+    Streams are served earliest deadline first: the next chunk goes to whichever
+    stream will run dry soonest. A stream nobody is pulling from right now (a
+    queued track filling up before it starts) counts as idleHandicapSeconds
+    further away, so it only gets the disk when the playing ones are comfortable.
+
+    Background work that isn't a stream (beat analysis, pre-decoding cues) calls
+    waitWhileStreamsAreUrgent() between chunks and steps aside while any playing
+    stream has less than urgentSeconds left.
+
+    Each stream keeps its own starvation stats; getReport() lists them.
+*/
+class StreamScheduler
+{
+public:
+    static constexpr int maxThreads = 4;
+    static constexpr double urgentSeconds = 0.5;
+    static constexpr double idleHandicapSeconds = 10.0;
+    static constexpr int idleWaitMs = 10;
+
+    //==============================================================================
+    class Stream
+    {
+    public:
+        virtual ~Stream() = default;
+
+        /** Decoded audio left in front of the play position, in seconds. */
+        virtual double getSecondsUntilUnderrun() const = 0;
+
+        /** Whether the audio thread has been pulling from it just now. */
+        virtual bool isActive() const = 0;
+
+        /** Cheap: is there anything for readNextChunk() to do? */
+        virtual bool hasWorkToDo() const = 0;
+
+        /** Reads one bounded chunk. Never called on two threads at once. */
+        virtual bool readNextChunk() = 0;
+
+        virtual juce::String getStreamName() const = 0;
+
+        /** The stream counts these itself, on the audio thread. */
+        std::atomic<int> underruns{0};
+
+    private:
+        friend class StreamScheduler;
+        juce::int64 chunksRead = 0;
+        double worstLeadSeconds = -1.0;//the least left when a chunk was started for it, while playing
+        bool busy = false;
+    };
+
+    //==============================================================================
+    StreamScheduler();
+    ~StreamScheduler();
+
+    void addStream (Stream* stream);
+
+    /** Waits for any chunk being read for it to finish. */
+    void removeStream (Stream* stream);
+
+    /** Any thread but the audio thread: something has work now, e.g. after a seek. */
+    void wake();
+
+    /** For background jobs: returns once no playing stream is urgent, or after maxMilliseconds. */
+    void waitWhileStreamsAreUrgent (int maxMilliseconds);
+
+    int getNumThreads() const noexcept          { return workers.size(); }
+    juce::Array<juce::Thread::ThreadID> getThreadIds() const;
+
+    /** Totals, then lead, worst lead, chunks and underruns for each stream, on one line. */
+    juce::String getReport() const;
+
+private:
+    class Worker;
+
+    bool serviceNextStream();//false if nothing needed anything
+    bool anyStreamIsUrgent() const;
+
+    juce::OwnedArray<Worker> workers;
+    juce::Array<Stream*> streams;
+    mutable juce::CriticalSection lock;
+    juce::WaitableEvent workAvailable;
+    juce::WaitableEvent chunkFinished{true};
+
+    //from streams that have gone, so the totals don't forget them
+    juce::int64 retiredChunks = 0;
+    int retiredUnderruns = 0;
+    std::atomic<int> backgroundWaits{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StreamScheduler)
+};
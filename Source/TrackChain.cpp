@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    TrackChain.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "TrackChain.h"
+#include "GrowingWavReader.h"
+
+void TrackChain::setReverse(bool shouldReverse)
+{
+    //the stream first, so cues and loops hand back to one that has already turned round
+    if(readAheadSource != nullptr)
+        readAheadSource->setReverse(shouldReverse);
+
+    if(residentSource != nullptr)
+        residentSource->setReverse(shouldReverse);
+
+    hotCueSource->setReverse(shouldReverse);
+    loopSource->setReverse(shouldReverse);
+    reversed = shouldReverse;
+}
+
+std::shared_ptr<TrackChain> TrackChain::create(juce::AudioFormatManager& formatManager, const juce::File& file,
+                                               StreamScheduler& scheduler, double readAheadSeconds,
+                                               const std::atomic<float>* loopEnabled, const std::atomic<float>* loopCrossfadeMs,
+                                               bool followGrowth, SampleStorage::Format storageFormat, bool decodeShortFiles)
+{
+    auto track = std::make_shared<TrackChain>();
+    track->file = file;
+
+    GrowingWavReader* growingReader = nullptr;
+
+    if(followGrowth && file.hasFileExtension("wav;wave"))
+        growingReader = GrowingWavReader::open(file);
+
+    juce::AudioFormatReader* reader = growingReader;
+
+    if(growingReader != nullptr)
+        track->readerSource.reset(new GrowingFileReaderSource(growingReader, true));
+    else if((reader = formatManager.createReaderFor(file)) != nullptr)
+        track->readerSource.reset(new juce::AudioFormatReaderSource(reader, true));
+    else
+        return nullptr;
+
+    track->sampleRate = reader->sampleRate;
+
+    juce::PositionableAudioSource* upstream = nullptr;
+
+    if(decodeShortFiles && growingReader == nullptr && reader->lengthInSamples <= (juce::int64) (residentClipSeconds * reader->sampleRate)){
+
+        //short enough to keep it all in memory, the reader isn't needed after this
+        track->residentSource.reset(new ResidentAudioSource(*reader, storageFormat));
+        track->readerSource = nullptr;
+        upstream = track->residentSource.get();
+    }
+    else{
+
+        track->readAheadSource.reset(new ReadAheadAudioSource(track->readerSource.get(), scheduler
+                ,(int) (readAheadSeconds * reader->sampleRate), 2));
+        track->readAheadSource->setStreamName(file.getFileName());
+        upstream = track->readAheadSource.get();
+    }
+
+    track->hotCueSource.reset(new HotCueAudioSource(upstream));
+    track->loopSource.reset(new LoopingAudioSource(track->hotCueSource.get(), track->sampleRate, loopEnabled, loopCrossfadeMs));
+
+    if(growingReader != nullptr){
+
+        auto* readAhead = track->readAheadSource.get();
+        readAhead->setFollowsGrowingSource(true);
+
+        track->growthWatcher.reset(new FileGrowthWatcher(file, [growingReader, readAhead]
+        {
+            growingReader->refresh();
+            readAhead->sourceHasGrown();
+        }));
+    }
+
+    return track;
+}
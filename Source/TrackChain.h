@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    TrackChain.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FileGrowthWatcher.h"
+#include "HotCueAudioSource.h"
+#include "LoopingAudioSource.h"
+#include "ReadAheadAudioSource.h"
+#include "ResidentAudioSource.h"
+#include <atomic>
+#include <memory>
+
+//==============================================================================
+/**
+    Everything that plays one file:
+    reader -> read-ahead -> hot cues -> loop, with getOutput() being the loop.
+    Files up to residentClipSeconds long are decoded whole into a ResidentAudioSource
+    instead of the reader and read-ahead, if create() is allowed to: that's reading
+    the whole file there and then.
+
+    setReverse() turns the whole chain round. Only the playlist calls it, on the
+    audio thread, for whichever track is current.
+
+    The processor keeps the current and the next track alive this way so the
+    playlist can go from one to the other without the audio thread waiting for
+    anything. Chains are shared_ptrs because background jobs decoding loop or
+    cue audio hold on to the chain they were started for.
+*/
+struct TrackChain
+{
+    juce::File file;
+    double sampleRate = 0.0;
+
+    std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
+    std::unique_ptr<ReadAheadAudioSource> readAheadSource;
+    std::unique_ptr<ResidentAudioSource> residentSource;//instead of the two above, for short files
+    std::unique_ptr<HotCueAudioSource> hotCueSource;
+    std::unique_ptr<LoopingAudioSource> loopSource;
+    std::unique_ptr<FileGrowthWatcher> growthWatcher;//only for followed files. declared last so it's the first to go
+
+    juce::PositionableAudioSource* getOutput() const    { return loopSource.get(); }
+
+    bool isFollowingGrowth() const                      { return growthWatcher != nullptr; }
+
+    void setReverse (bool shouldReverse);
+    bool isReversed() const                             { return reversed; }
+
+    /** Opens the file and builds the chain. Returns nullptr if it can't be read.
+        With followGrowth, a WAV that is still being written keeps getting longer
+        as it's written; other formats open as they are. Without decodeShortFiles
+        every file streams, which keeps this quick enough for the message thread.
+        Safe to call from a background thread. */
+    static std::shared_ptr<TrackChain> create (juce::AudioFormatManager& formatManager, const juce::File& file,
+                                               StreamScheduler& scheduler, double readAheadSeconds,
+                                               const std::atomic<float>* loopEnabled, const std::atomic<float>* loopCrossfadeMs,
+                                               bool followGrowth = false,
+                                               SampleStorage::Format storageFormat = SampleStorage::Format::float32,
+                                               bool decodeShortFiles = true);
+
+    static constexpr double residentClipSeconds = 30.0;
+
+private:
+    bool reversed = false;
+};
@@ -0,0 +1,230 @@
+/*
+  ==============================================================================
+
+    TruePeakLimiter.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "TruePeakLimiter.h"
+#include <cmath>
+#include <cstring>
+
+template <>
+TruePeakLimiter::Buffers<float>& TruePeakLimiter::getBuffers<float>()   { return floatBuffers; }
+
+template <>
+TruePeakLimiter::Buffers<double>& TruePeakLimiter::getBuffers<double>() { return doubleBuffers; }
+
+template <typename FloatType>
+void TruePeakLimiter::Buffers<FloatType>::allocate(int historyLength, int delayLength, int numSamples)
+{
+    history.setSize(maxChannels, historyLength + numSamples);
+    delay.setSize(maxChannels, delayLength + numSamples);
+    history.clear();
+    delay.clear();
+
+    interpolated.allocate((size_t) numSamples, true);
+    peaks.allocate((size_t) numSamples, true);
+    gains.allocate((size_t) numSamples, true);
+}
+
+//==============================================================================
+void TruePeakLimiter::addParameters(std::vector<std::unique_ptr<juce::RangedAudioParameter>>& params)
+{
+    params.push_back(std::make_unique<juce::AudioParameterBool>("LIMIT","Limiter",true));//latency stays reported either way
+    params.push_back(std::make_unique<juce::AudioParameterFloat>("CEILING","Limiter Ceiling",
+            juce::NormalisableRange<float>(-12.0f,0.0f,0.1f),-1.0f));//dBTP
+}
+
+TruePeakLimiter::TruePeakLimiter(juce::AudioProcessorValueTreeState& apvts)
+    : enabledParameter(apvts.getRawParameterValue("LIMIT"))
+    , ceilingParameter(apvts.getRawParameterValue("CEILING"))
+{
+    //windowed sinc cut off at the original Nyquist, centred between taps 23 and 24.
+    //branch k, tap j is prototype tap 4j + k, so branch k lands k/4 of a sample
+    //after n - 5.875: every point falls between inputs n - 6 and n - 5
+    constexpr int length = oversampling * tapsPerPhase;
+    const double centre = (length - 1) * 0.5;
+
+    for(int k = 0; k < oversampling; ++k){
+
+        double sum = 0.0;
+
+        for(int j = 0; j < tapsPerPhase; ++j){
+            auto i = j * oversampling + k;
+            auto x = ((double) i - centre) / oversampling;
+            auto sinc = std::sin(juce::MathConstants<double>::pi * x) / (juce::MathConstants<double>::pi * x);
+            auto blackman = 0.42 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * (i + 0.5) / length)
+                                 + 0.08 * std::cos(2.0 * juce::MathConstants<double>::twoPi * (i + 0.5) / length);
+
+            phases[(size_t) k][(size_t) j] = sinc * blackman;
+            sum += sinc * blackman;
+        }
+
+        for(auto& tap : phases[(size_t) k])
+            tap /= sum;//unity gain at DC on every branch
+    }
+}
+
+void TruePeakLimiter::prepare(double sampleRate, int maximumBlockSize)
+{
+    capacity = juce::jmax(maximumBlockSize, 64);
+    lookahead = juce::jmax(1, (int) std::ceil(lookaheadSeconds * sampleRate));
+
+    //a peak found at input n belongs to samples n - 6 and n - 5. holding two samples
+    //longer than the average is wide covers both of them once they are delayed by
+    //lookahead + 6
+    holdLength = lookahead + 2;
+    latency = lookahead + interpolatorDelay;
+    releaseCoefficient = (float) (1.0 - std::exp(-1.0 / (releaseSeconds * sampleRate)));
+
+    holdValues.assign((size_t) holdLength + 1, 1.0f);
+    holdIndices.assign((size_t) holdLength + 1, 0);
+    boxValues.assign((size_t) lookahead, 1.0f);
+
+    floatBuffers.allocate(tapsPerPhase - 1, latency, capacity);
+    doubleBuffers.allocate(tapsPerPhase - 1, latency, capacity);
+
+    reset();
+}
+
+void TruePeakLimiter::reset()
+{
+    releasedGain = 1.0f;
+    holdFront = 0;
+    holdSize = 0;
+    sampleIndex = 0;
+    std::fill(boxValues.begin(), boxValues.end(), 1.0f);
+    boxPosition = 0;
+    boxSum = (double) boxValues.size();
+
+    floatBuffers.history.clear();
+    floatBuffers.delay.clear();
+    doubleBuffers.history.clear();
+    doubleBuffers.delay.clear();
+
+    gainReduction = 0.0f;
+}
+
+//==============================================================================
+template <typename FloatType>
+void TruePeakLimiter::detectPeaks(Buffers<FloatType>& buffers, int numChannels, int numSamples)
+{
+    using FVO = juce::FloatVectorOperations;
+
+    auto* peaks = buffers.peaks.getData();
+    auto* interpolated = buffers.interpolated.getData();
+
+    FVO::clear(peaks, numSamples);
+
+    for(int channel = 0; channel < numChannels; ++channel){
+
+        //history[tapsPerPhase - 1 + n] is input n
+        auto* history = buffers.history.getReadPointer(channel);
+
+        //the last real sample before the interpolated points
+        FVO::abs(interpolated, history + tapsPerPhase - 1 - (interpolatorDelay - 1), numSamples);
+        FVO::max(peaks, peaks, interpolated, numSamples);
+
+        for(auto& phase : phases){
+
+            FVO::clear(interpolated, numSamples);
+
+            for(int j = 0; j < tapsPerPhase; ++j)
+                FVO::addWithMultiply(interpolated, history + tapsPerPhase - 1 - j, (FloatType) phase[(size_t) j], numSamples);
+
+            FVO::abs(interpolated, interpolated, numSamples);
+            FVO::max(peaks, peaks, interpolated, numSamples);
+        }
+    }
+}
+
+template <typename FloatType>
+void TruePeakLimiter::computeGains(Buffers<FloatType>& buffers, int numSamples, bool enabled, float& lowestGain)
+{
+    auto* peaks = buffers.peaks.getData();
+    auto* gains = buffers.gains.getData();
+    const auto ceiling = juce::Decibels::decibelsToGain(ceilingParameter->load());
+    const auto holdCapacity = (int) holdValues.size();
+
+    for(int i = 0; i < numSamples; ++i, ++sampleIndex){
+
+        auto peak = enabled ? (float) peaks[i] : 0.0f;
+        auto target = peak > ceiling ? ceiling / peak : 1.0f;
+
+        //down at once, back up over the release
+        releasedGain = juce::jmin(target, releasedGain + (1.0f - releasedGain) * releaseCoefficient);
+
+        //running minimum over holdLength
+        while(holdSize > 0 && holdValues[(size_t) ((holdFront + holdSize - 1) % holdCapacity)] >= releasedGain)
+            --holdSize;
+
+        auto back = (holdFront + holdSize) % holdCapacity;
+        holdValues[(size_t) back] = releasedGain;
+        holdIndices[(size_t) back] = sampleIndex;
+        ++holdSize;
+
+        if(holdIndices[(size_t) holdFront] <= sampleIndex - holdLength){
+            holdFront = (holdFront + 1) % holdCapacity;
+            --holdSize;
+        }
+
+        auto held = holdValues[(size_t) holdFront];
+
+        //averaging the held minimum over the lookahead reaches it by the time the peak comes out
+        boxSum += held - boxValues[(size_t) boxPosition];
+        boxValues[(size_t) boxPosition] = held;
+        boxPosition = (boxPosition + 1) % lookahead;
+
+        auto gain = juce::jmin(1.0f, (float) (boxSum / lookahead));
+        gains[i] = (FloatType) gain;
+        lowestGain = juce::jmin(lowestGain, gain);
+    }
+}
+
+template <typename FloatType>
+void TruePeakLimiter::process(juce::AudioBuffer<FloatType>& buffer)
+{
+    using FVO = juce::FloatVectorOperations;
+
+    if(capacity == 0)
+        return;
+
+    auto& buffers = getBuffers<FloatType>();
+    const auto numChannels = juce::jmin(buffer.getNumChannels(), (int) maxChannels);
+    const bool enabled = enabledParameter->load() > 0.5f;
+    float lowestGain = 1.0f;
+
+    for(int chunkStart = 0; chunkStart < buffer.getNumSamples(); chunkStart += capacity){
+
+        auto numSamples = juce::jmin(capacity, buffer.getNumSamples() - chunkStart);
+
+        for(int channel = 0; channel < numChannels; ++channel){
+            FVO::copy(buffers.history.getWritePointer(channel, tapsPerPhase - 1), buffer.getReadPointer(channel, chunkStart), numSamples);
+            FVO::copy(buffers.delay.getWritePointer(channel, latency), buffer.getReadPointer(channel, chunkStart), numSamples);
+        }
+
+        if(enabled)
+            detectPeaks(buffers, numChannels, numSamples);
+
+        computeGains(buffers, numSamples, enabled, lowestGain);
+
+        for(int channel = 0; channel < numChannels; ++channel){
+
+            auto* delay = buffers.delay.getWritePointer(channel);
+            FVO::multiply(buffer.getWritePointer(channel, chunkStart), delay, buffers.gains.getData(), numSamples);
+
+            //keep the tails for the next block. these can overlap when blocks are short
+            auto* history = buffers.history.getWritePointer(channel);
+            std::memmove(history, history + numSamples, sizeof(FloatType) * (size_t) (tapsPerPhase - 1));
+            std::memmove(delay, delay + numSamples, sizeof(FloatType) * (size_t) latency);
+        }
+    }
+
+    gainReduction.store(-juce::Decibels::gainToDecibels(lowestGain, -60.0f), std::memory_order_relaxed);
+}
+
+template void TruePeakLimiter::process(juce::AudioBuffer<float>&);
+template void TruePeakLimiter::process(juce::AudioBuffer<double>&);
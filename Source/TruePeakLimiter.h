@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    TruePeakLimiter.h
+    Created: 19 Oct 2026
+
+    Lookahead brickwall limiter on the output bus, the last thing processBlock
+    does. Keeps inter-sample peaks under CEILING too, not just the samples.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+    Peaks are found on a 4x oversampled copy of the signal: a 48 tap windowed
+    sinc split into four polyphase branches, run over whole blocks with
+    FloatVectorOperations. The gain needed to keep each peak under the ceiling
+    is released exponentially, held for the lookahead and then box averaged
+    over it, which ramps the gain down in time to meet the peak. The audio is
+    delayed by the lookahead plus the interpolator's delay, and that is what
+    getLatencySamples() reports.
+
+    Switching LIMIT off leaves the delay in so the latency the host has been
+    told about stays true; only the gain stops moving.
+*/
+class TruePeakLimiter
+{
+public:
+    static constexpr int oversampling = 4;
+    static constexpr int tapsPerPhase = 12;
+    static constexpr int maxChannels = 2;
+    static constexpr double lookaheadSeconds = 0.002;
+    static constexpr double releaseSeconds = 0.1;
+
+    /** Adds LIMIT and CEILING. */
+    static void addParameters (std::vector<std::unique_ptr<juce::RangedAudioParameter>>& params);
+
+    explicit TruePeakLimiter (juce::AudioProcessorValueTreeState& apvts);
+
+    void prepare (double sampleRate, int maximumBlockSize);
+    void reset();
+
+    /** Valid after prepare. */
+    int getLatencySamples() const noexcept          { return latency; }
+
+    /** Audio thread. Delays and limits the first two channels in place. */
+    template <typename FloatType>
+    void process (juce::AudioBuffer<FloatType>& buffer);
+
+    /** Any thread: how far the gain was pulled down in the last block, in dB (0 or positive). */
+    float getGainReductionDecibels() const noexcept { return gainReduction.load (std::memory_order_relaxed); }
+
+private:
+    //the oversampled points for input n lie between n-6 and n-5, see prepare()
+    static constexpr int interpolatorDelay = tapsPerPhase / 2;
+
+    template <typename FloatType>
+    struct Buffers
+    {
+        juce::AudioBuffer<FloatType> history;//tapsPerPhase - 1 old samples, then the block
+        juce::AudioBuffer<FloatType> delay;//latency old samples, then the block
+        juce::HeapBlock<FloatType> interpolated, peaks, gains;
+
+        void allocate (int historyLength, int delayLength, int capacity);
+    };
+
+    template <typename FloatType> Buffers<FloatType>& getBuffers();
+
+    template <typename FloatType>
+    void detectPeaks (Buffers<FloatType>& buffers, int numChannels, int numSamples);
+
+    template <typename FloatType>
+    void computeGains (Buffers<FloatType>& buffers, int numSamples, bool enabled, float& lowestGain);
+
+    std::atomic<float>* enabledParameter = nullptr;
+    std::atomic<float>* ceilingParameter = nullptr;
+
+    std::array<std::array<double, tapsPerPhase>, oversampling> phases;
+
+    int capacity = 0;
+    int lookahead = 1;
+    int holdLength = 3;
+    int latency = 0;
+    float releaseCoefficient = 0.0f;
+
+    //gain computer state
+    float releasedGain = 1.0f;
+    std::vector<float> holdValues;//monotonic queue for the running minimum
+    std::vector<juce::int64> holdIndices;
+    int holdFront = 0, holdSize = 0;
+    juce::int64 sampleIndex = 0;
+    std::vector<float> boxValues;
+    int boxPosition = 0;
+    double boxSum = 0.0;
+
+    Buffers<float> floatBuffers;
+    Buffers<double> doubleBuffers;
+
+    std::atomic<float> gainReduction{0.0f};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TruePeakLimiter)
+};